@@ -0,0 +1,157 @@
+/**
+ * @file face_stream_client.c
+ * @brief Host-side decoder for the face_stream protocol
+ *
+ * Connects to a unit running face_stream_start(), rebuilds every frame
+ * from its tiles and keeps the latest one in a PPM file.  Prints the size
+ * of each frame so the delta savings can be checked.
+ *
+ *   cc -O2 -o face_stream_client face_stream_client.c
+ *   ./face_stream_client 127.0.0.1 5515 face.ppm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+static int read_all(int fd, void *buf, size_t len)
+{
+    uint8_t *p = buf;
+    while (len)
+    {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n <= 0)
+            return -1;
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static void write_ppm(const char *path, const uint16_t *px, uint16_t w, uint16_t h)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return;
+    fprintf(f, "P6\n%u %u\n255\n", w, h);
+    for (uint32_t i = 0; i < (uint32_t)w * h; i++)
+    {
+        uint8_t rgb[3] = {
+            (uint8_t)((px[i] >> 8) & 0xF8),
+            (uint8_t)((px[i] >> 3) & 0xFC),
+            (uint8_t)(px[i] << 3),
+        };
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+}
+
+/* Expand one tile's runs into the frame; returns -1 on malformed data */
+static int decode_tile(const uint8_t *p, uint16_t len, uint16_t *frame, uint16_t face_sz,
+                       uint16_t x0, uint16_t y0, uint16_t w, uint16_t h)
+{
+    uint32_t i = 0, n = (uint32_t)w * h;
+    for (uint16_t o = 0; o + 3 <= len; o += 3)
+    {
+        uint32_t run = p[o] + 1u;
+        uint16_t c = get_u16(p + o + 1);
+        if (i + run > n)
+            return -1;
+        for (; run; run--, i++)
+            frame[(y0 + i / w) * face_sz + x0 + i % w] = c;
+    }
+    return i == n ? 0 : -1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *host = argc > 1 ? argv[1] : "127.0.0.1";
+    int port = argc > 2 ? atoi(argv[2]) : 5515;
+    const char *out = argc > 3 ? argv[3] : "face.ppm";
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    if (fd < 0 || inet_pton(AF_INET, host, &addr.sin_addr) != 1 ||
+        connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("connect");
+        return 1;
+    }
+
+    uint16_t *frame = NULL;
+    uint16_t face_sz = 0;
+    uint8_t tile_buf[4 + 64 * 64 * 3];
+
+    for (;;)
+    {
+        uint8_t hdr[14];
+        if (read_all(fd, hdr, sizeof(hdr)) < 0)
+            break;
+        if (hdr[0] != 'K' || hdr[1] != 'F')
+        {
+            fprintf(stderr, "bad frame header\n");
+            break;
+        }
+
+        uint8_t key = hdr[2] & 1, tile = hdr[3];
+        uint16_t w = get_u16(hdr + 4);
+        uint32_t time_ms = get_u16(hdr + 8) | ((uint32_t)get_u16(hdr + 10) << 16);
+        uint16_t count = get_u16(hdr + 12);
+
+        if (key && w != face_sz)
+        {
+            free(frame);
+            face_sz = w;
+            frame = calloc((size_t)face_sz * face_sz, sizeof(uint16_t));
+            if (!frame)
+                return 1;
+        }
+        if (!frame)
+        {
+            fprintf(stderr, "delta before keyframe\n");
+            break;
+        }
+
+        uint16_t tiles_x = (face_sz + tile - 1) / tile;
+        size_t bytes = sizeof(hdr);
+        for (uint16_t t = 0; t < count; t++)
+        {
+            if (read_all(fd, tile_buf, 4) < 0)
+                goto done;
+            uint16_t index = get_u16(tile_buf), len = get_u16(tile_buf + 2);
+            if (len > sizeof(tile_buf) - 4 || read_all(fd, tile_buf + 4, len) < 0)
+                goto done;
+            bytes += 4u + len;
+
+            uint16_t x0 = (index % tiles_x) * tile, y0 = (index / tiles_x) * tile;
+            uint16_t tw = face_sz - x0 < tile ? face_sz - x0 : tile;
+            uint16_t th = face_sz - y0 < tile ? face_sz - y0 : tile;
+            if (y0 >= face_sz || decode_tile(tile_buf + 4, len, frame, face_sz, x0, y0, tw, th) < 0)
+            {
+                fprintf(stderr, "bad tile %u\n", index);
+                goto done;
+            }
+        }
+
+        write_ppm(out, frame, face_sz, face_sz);
+        printf("%8u ms  %s  %4u tiles  %6zu B\n", time_ms, key ? "key  " : "delta", count, bytes);
+        fflush(stdout);
+    }
+
+done:
+    free(frame);
+    close(fd);
+    return 0;
+}
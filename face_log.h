@@ -0,0 +1,24 @@
+/**
+ * @file face_log.h
+ * @brief Log macros shared by the face sources: ESP_LOG on ESP-IDF, printf
+ *        elsewhere
+ *
+ * Internal to the lvgl_kawaii_face component.
+ */
+
+#ifndef FACE_LOG_H
+#define FACE_LOG_H
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+#define FACE_LOGI(tag, ...) ESP_LOGI(tag, __VA_ARGS__)
+#define FACE_LOGE(tag, ...) ESP_LOGE(tag, __VA_ARGS__)
+#define FACE_LOGW(tag, ...) ESP_LOGW(tag, __VA_ARGS__)
+#else
+#include <stdio.h>
+#define FACE_LOGI(tag, fmt, ...) printf("[I][%s] " fmt "\n", tag, ##__VA_ARGS__)
+#define FACE_LOGE(tag, fmt, ...) printf("[E][%s] " fmt "\n", tag, ##__VA_ARGS__)
+#define FACE_LOGW(tag, fmt, ...) printf("[W][%s] " fmt "\n", tag, ##__VA_ARGS__)
+#endif
+
+#endif // FACE_LOG_H
@@ -0,0 +1,316 @@
+/**
+ * @file face_matrix.c
+ * @brief Low-resolution face rasterizer for LED matrices
+ */
+
+#include "face_matrix.h"
+#include "face_trig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Eye width of the canvas face at FACE_MATRIX_REF_SIZE (0.45 * 0.75) */
+#define REF_EYE_W 81
+
+typedef struct {
+    uint8_t r, g, b;
+} rgb_t;
+
+static const rgb_t EYE_COLOR = {255, 255, 255};
+static const rgb_t IRIS_COLOR = {50, 180, 255};
+static const rgb_t PUPIL_COLOR = {0, 0, 0};
+static const rgb_t BROW_COLOR = {160, 110, 60};
+static const rgb_t HEART_COLOR = {255, 60, 120};
+static const rgb_t MOUTH_COLOR = {220, 40, 60};
+static const rgb_t TONGUE_COLOR = {255, 130, 150};
+static const rgb_t SPARKLE_COLOR = {255, 240, 100};
+static const rgb_t BLUSH_COLOR = {255, 150, 180};
+
+/* 7x6 heart, sampled nearest-neighbour down to the eye size */
+static const uint8_t s_heart[6] = {
+    0x36, // .XX.XX.
+    0x7F, // XXXXXXX
+    0x7F, // XXXXXXX
+    0x3E, // .XXXXX.
+    0x1C, // ..XXX..
+    0x08, // ...X...
+};
+
+typedef struct {
+    uint8_t *px;
+    int32_t w;
+    int32_t h;
+} fb_t;
+
+static void put(const fb_t *fb, int32_t x, int32_t y, rgb_t c)
+{
+    if (x < 0 || y < 0 || x >= fb->w || y >= fb->h)
+        return;
+    uint8_t *p = fb->px + (y * fb->w + x) * 3;
+    p[0] = c.r;
+    p[1] = c.g;
+    p[2] = c.b;
+}
+
+static void fill(const fb_t *fb, int32_t x1, int32_t y1, int32_t x2, int32_t y2, rgb_t c)
+{
+    for (int32_t y = y1; y <= y2; y++)
+        for (int32_t x = x1; x <= x2; x++)
+            put(fb, x, y, c);
+}
+
+static void line(const fb_t *fb, int32_t x0, int32_t y0, int32_t x1, int32_t y1, rgb_t c)
+{
+    int32_t dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int32_t dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx + dy;
+
+    for (;;)
+    {
+        put(fb, x0, y0, c);
+        if (x0 == x1 && y0 == y1)
+            break;
+        int32_t e2 = 2 * err;
+        if (e2 >= dy)
+        {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx)
+        {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+static int32_t clamp_i(int32_t v, int32_t lo, int32_t hi)
+{
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+static rgb_t dim(rgb_t c, uint8_t percent)
+{
+    return (rgb_t){(uint8_t)(c.r * percent / 100), (uint8_t)(c.g * percent / 100),
+                   (uint8_t)(c.b * percent / 100)};
+}
+
+/* Reference-px Q8 offset to whole matrix pixels, rounded */
+static int32_t scale_q8(int32_t q8, int32_t eye_w)
+{
+    int32_t den = REF_EYE_W * 256;
+    int32_t num = q8 * eye_w;
+    return (num + (num >= 0 ? den / 2 : -den / 2)) / den;
+}
+
+/* Parabola through the span's ends peaking at `depth` mid-span */
+static int32_t arc_y(int32_t x, int32_t x1, int32_t x2, int32_t depth)
+{
+    int32_t half = x2 - x1;
+    int32_t d = 2 * x - (x1 + x2);
+    if (!half)
+        return depth;
+    int32_t num = depth * (half * half - d * d);
+    int32_t den = half * half;
+    return (num + (num >= 0 ? den / 2 : -den / 2)) / den;
+}
+
+static void draw_heart(const fb_t *fb, int32_t x1, int32_t y1, int32_t w)
+{
+    int32_t h = w * 6 / 7 > 0 ? w * 6 / 7 : 1;
+    for (int32_t j = 0; j < h; j++)
+    {
+        uint8_t row = s_heart[j * 6 / h];
+        for (int32_t i = 0; i < w; i++)
+        {
+            if (row & (0x40 >> (i * 7 / w)))
+                put(fb, x1 + i, y1 + j, HEART_COLOR);
+        }
+    }
+}
+
+/* One eye spanning columns x1..x2, centred on row cy */
+static void draw_eye(const fb_t *fb, int32_t s, int32_t x1, int32_t x2, int32_t cy,
+                     uint8_t openness, int8_t brow_angle, bool is_left,
+                     const face_matrix_pose_t *pose)
+{
+    int32_t eye_w = x2 - x1 + 1;
+    int32_t cx2 = x1 + x2;  // Twice the centre column
+
+    /* Brows need a few rows above the eye to read as brows */
+    if (s >= 24)
+    {
+        int32_t by = cy - eye_w / 2 - 2 + scale_q8(pose->brow_height * 256, eye_w);
+        int32_t dy = (eye_w * face_sin_q15(FACE_TRIG_DEG(brow_angle)) + 2 * 32768) >> 17;
+        if (!is_left)
+            dy = -dy;
+        line(fb, x1, by - dy, x2, by + dy, BROW_COLOR);
+    }
+
+    if (pose->hearts && openness > 20)
+    {
+        int32_t hh = eye_w * 6 / 7;
+        draw_heart(fb, x1, cy - hh / 2, eye_w);
+        return;
+    }
+
+    if (openness <= 20)
+    {
+        fill(fb, x1, cy, x2, cy, EYE_COLOR);
+        return;
+    }
+
+    int32_t eye_h = clamp_i(eye_w * openness / 100, 2, eye_w);
+    int32_t y1 = cy - eye_h / 2;
+    int32_t y2 = y1 + eye_h - 1;
+    fill(fb, x1, y1, x2, y2, EYE_COLOR);
+    if (eye_w >= 4 && eye_h >= 4)
+    {
+        rgb_t off = {0, 0, 0};
+        put(fb, x1, y1, off);
+        put(fb, x2, y1, off);
+        put(fb, x1, y2, off);
+        put(fb, x2, y2, off);
+    }
+
+    /* Iris and pupil move together, kept inside the eye */
+    int32_t iris_w = (eye_w + 1) / 2;
+    int32_t iris_h = iris_w < eye_h - 1 ? iris_w : eye_h - 1;
+    if (iris_h >= 1)
+    {
+        int32_t ix1 = (cx2 - iris_w + 1) / 2 + scale_q8(pose->pupil_x_q8, eye_w);
+        int32_t iy1 = cy - iris_h / 2 + scale_q8(pose->pupil_y_q8, eye_w);
+        ix1 = clamp_i(ix1, x1, x2 - iris_w + 1);
+        iy1 = clamp_i(iy1, y1, y2 - iris_h + 1);
+        fill(fb, ix1, iy1, ix1 + iris_w - 1, iy1 + iris_h - 1, IRIS_COLOR);
+
+        if (iris_w >= 3 && iris_h >= 3)
+        {
+            int32_t pw = iris_w / 3 | 1;
+            int32_t px1 = ix1 + (iris_w - pw) / 2;
+            int32_t py1 = iy1 + (iris_h - pw) / 2;
+            fill(fb, px1, py1, px1 + pw - 1, py1 + pw - 1, PUPIL_COLOR);
+            if (iris_w >= 5)
+                put(fb, px1 - 1, py1 - 1, EYE_COLOR);
+        }
+    }
+
+    if (pose->blush > 0)
+    {
+        int32_t bw = s >= 24 ? 3 : 2;
+        int32_t bx = is_left ? x1 : x2 - bw + 1;
+        fill(fb, bx, y2 + 2, bx + bw - 1, y2 + 2, dim(BLUSH_COLOR, pose->blush));
+    }
+
+    if (pose->sparkle > 0 && s >= 24)
+    {
+        uint16_t a = (uint16_t)(pose->sparkle * 0x10000 / 100);
+        int32_t r = eye_w / 2 + 2;
+        put(fb, cx2 / 2 + ((r * face_cos_q15(a) + 16384) >> 15), cy + ((r * face_sin_q15(a) + 16384) >> 15),
+            dim(SPARKLE_COLOR, pose->sparkle));
+    }
+}
+
+static void draw_mouth(const fb_t *fb, int32_t s, int32_t x1, int32_t x2, int32_t my,
+                       const face_matrix_pose_t *pose)
+{
+    int8_t curve = pose->mouth_curve;
+    int32_t depth = s * 3 / 16 > 2 ? s * 3 / 16 : 2;
+
+    if (pose->grit)
+    {
+        /* Teeth bar, split into teeth once they are wide enough */
+        int32_t rows = s >= 24 ? 3 : 2;
+        fill(fb, x1, my - rows / 2, x2, my - rows / 2 + rows - 1, EYE_COLOR);
+        if (s >= 24)
+        {
+            for (int32_t x = x1 + 3; x < x2; x += 3)
+                fill(fb, x, my - rows / 2, x, my - rows / 2 + rows - 1, MOUTH_COLOR);
+        }
+    }
+    else if (curve > 65)
+    {
+        /* Open grin: a D hanging from a straight upper lip */
+        for (int32_t x = x1; x <= x2; x++)
+            fill(fb, x, my, x, my + arc_y(x, x1, x2, depth), MOUTH_COLOR);
+        if (s >= 24)
+            fill(fb, x1 + 1, my, x2 - 1, my, EYE_COLOR);
+        if (curve > 100)
+        {
+            int32_t mid = (x1 + x2) / 2;
+            fill(fb, mid - (s >= 24), my + depth - 1, mid + 1, my + depth, TONGUE_COLOR);
+        }
+    }
+    else if (curve > 35)
+    {
+        /* Round "o": a plus at 16 px, a disc above */
+        int32_t r = s / 10 > 1 ? s / 10 : 1;
+        int32_t cx = (x1 + x2) / 2;
+        for (int32_t dy = -r; dy <= r; dy++)
+            for (int32_t dx = -r; dx <= r; dx++)
+                if (dx * dx + dy * dy <= r * r)
+                    put(fb, cx + dx, my + dy, MOUTH_COLOR);
+    }
+    else
+    {
+        /* One-pixel line bent by the curve; a frown bends the other way */
+        int32_t bend = s / 16 > 1 ? s / 16 : 1;
+        int32_t d = curve < -35 ? -bend : (curve * (bend + 1)) / 35;
+        int32_t py = my + arc_y(x1, x1, x2, d);
+        for (int32_t x = x1; x <= x2; x++)
+        {
+            int32_t y = my + arc_y(x, x1, x2, d);
+            line(fb, x - (x > x1), py, x, y, EYE_COLOR);
+            py = y;
+        }
+    }
+}
+
+void face_matrix_render(uint8_t *rgb, uint16_t width, uint16_t height,
+                        const face_matrix_pose_t *pose)
+{
+    fb_t fb = {rgb, width, height};
+    memset(rgb, 0, (size_t)width * height * 3);
+
+    int32_t s = width < height ? width : height;
+    int32_t ox = (width - s) / 2;
+    int32_t oy = (height - s) / 2;
+
+    /* Features are laid out on the left half and mirrored, so the face
+     * stays symmetric whatever the parity of the size */
+    int32_t eye_w = (s * 5 + 8) / 16 > 3 ? (s * 5 + 8) / 16 : 3;
+    int32_t bounce = scale_q8(pose->bounce_q8, eye_w);
+    int32_t ex1 = ox + s / 4 - eye_w / 2;
+    int32_t ex2 = ex1 + eye_w - 1;
+    int32_t ey = oy + s * 3 / 8 + bounce;
+
+    draw_eye(&fb, s, ex1, ex2, ey, pose->left_openness, pose->left_brow_angle, true, pose);
+    draw_eye(&fb, s, 2 * ox + s - 1 - ex2, 2 * ox + s - 1 - ex1, ey,
+             pose->right_openness, pose->right_brow_angle, false, pose);
+
+    int32_t mw = s * 7 / 16;
+    int32_t mx1 = ox + (s - mw) / 2;
+    int32_t mx2 = 2 * ox + s - 1 - mx1;
+    draw_mouth(&fb, s, mx1, mx2, oy + s * 11 / 16 + bounce, pose);
+}
+
+void face_matrix_dump(const uint8_t *rgb, uint16_t width, uint16_t height, void *user_data)
+{
+    FILE *out = user_data ? (FILE *)user_data : stdout;
+    static const uint8_t off[3] = {0, 0, 0};
+
+    /* Upper pixel as foreground of a half block, lower one as background */
+    fputs("\x1b[H", out);
+    for (uint16_t y = 0; y < height; y += 2)
+    {
+        for (uint16_t x = 0; x < width; x++)
+        {
+            const uint8_t *top = rgb + (y * width + x) * 3;
+            const uint8_t *bottom = y + 1 < height ? top + width * 3 : off;
+            fprintf(out, "\x1b[38;2;%u;%u;%um\x1b[48;2;%u;%u;%um\xe2\x96\x80",
+                    top[0], top[1], top[2], bottom[0], bottom[1], bottom[2]);
+        }
+        fputs("\x1b[0m\n", out);
+    }
+    fflush(out);
+}
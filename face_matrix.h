@@ -0,0 +1,52 @@
+/**
+ * @file face_matrix.h
+ * @brief Pixel-level face for LED matrices (16x16, 32x32, 64x32, ...)
+ *
+ * At matrix resolution the canvas features would only blur into a few
+ * mixed pixels, so every feature is redrawn from the pose with shapes
+ * picked for low pixel counts: blocky eyes with a one-pixel pupil, a
+ * one-pixel mouth line, brows and sparkles only once there is room for
+ * them.  Dark background, as unlit LEDs are black.  Plain C, no LVGL.
+ *
+ * Internal to the lvgl_kawaii_face component.
+ */
+
+#ifndef FACE_MATRIX_H
+#define FACE_MATRIX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Face size the pose's pixel offsets (pupils, bounce, brows) are tuned for;
+ * they are scaled by the matrix size over this */
+#define FACE_MATRIX_REF_SIZE 240
+
+/* Everything the matrix face depends on, in the units of face_state */
+typedef struct {
+    uint8_t left_openness;      // 0..100
+    uint8_t right_openness;
+    int8_t mouth_curve;
+    int8_t left_brow_angle;     // Degrees
+    int8_t right_brow_angle;
+    int8_t brow_height;         // Reference px
+    uint8_t blush;              // 0..100
+    uint8_t sparkle;            // 0..100
+    int16_t pupil_x_q8;         // Reference px, Q8
+    int16_t pupil_y_q8;
+    int16_t bounce_q8;
+    bool hearts;                // Heart eyes
+    bool grit;                  // Clenched teeth
+} face_matrix_pose_t;
+
+/*
+ * Draw `pose` into `rgb`, width x height RGB888 pixels (R, G, B bytes, rows
+ * without padding).  The face is the centred min(width, height) square.
+ */
+void face_matrix_render(uint8_t *rgb, uint16_t width, uint16_t height,
+                        const face_matrix_pose_t *pose);
+
+/* Public in lvgl_kawaii_face.h; declared here too so that this file
+ * builds without LVGL */
+void face_matrix_dump(const uint8_t *rgb, uint16_t width, uint16_t height, void *user_data);
+
+#endif // FACE_MATRIX_H
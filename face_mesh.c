@@ -0,0 +1,149 @@
+/**
+ * @file face_mesh.c
+ * @brief Blend-shape tables and fixed-point evaluation for mouth and eyes
+ */
+
+#include "face_mesh.h"
+#include <math.h>
+#include <stdbool.h>
+
+#define Q6(v) ((int8_t)lroundf((v) * 64.0f))
+
+#define MOUTH_UPPER 9   // Vertices on the upper lip, corners included
+
+static face_mesh_t s_mouth;
+static face_mesh_t s_eye;
+static bool s_built;
+
+/* Lip vertex `i` sits at x in [-1, 1]; upper lip left to right, lower lip
+ * back from right to left without the shared corners */
+static float mouth_vertex_x(int i, bool *upper)
+{
+    *upper = i < MOUTH_UPPER;
+    if (*upper)
+        return -1.0f + 2.0f * i / (MOUTH_UPPER - 1);
+    return 1.0f - 2.0f * (i - MOUTH_UPPER + 1) / (MOUTH_UPPER - 1);
+}
+
+/*
+ * The outlines are plain formulas in x; they are sampled once into Q6
+ * tables so that a frame only does integer multiply-adds.  Mouth y is in
+ * half-heights (down is positive), b = 1 - x^2 peaks mid-lip.
+ */
+static void build_mouth(void)
+{
+    face_mesh_t *m = &s_mouth;
+    m->verts = FACE_MESH_MAX_VERTS;
+    m->shapes = FACE_MOUTH_SHAPE_COUNT;
+
+    for (int i = 0; i < m->verts; i++)
+    {
+        bool up;
+        float x = mouth_vertex_x(i, &up);
+        float b = 1.0f - x * x;
+        float bx = 0.7f * x;
+        float by = up ? -0.1f * b : 0.2f * b;
+
+        m->base_x[i] = Q6(bx);
+        m->base_y[i] = Q6(by);
+
+        /* Corners rise and the lower lip drops into a D-shaped grin */
+        m->dx[FACE_MOUTH_SMILE][i] = Q6(0.3f * x);
+        m->dy[FACE_MOUTH_SMILE][i] = Q6(up ? 0.25f * b - 0.35f * x * x : 0.7f * b - 0.35f * x * x);
+
+        /* Corners drop under an arched upper lip */
+        m->dx[FACE_MOUTH_FROWN][i] = Q6(0.15f * x);
+        m->dy[FACE_MOUTH_FROWN][i] = Q6(up ? -0.45f * b + 0.35f * x * x : -0.2f * b + 0.35f * x * x);
+
+        m->dx[FACE_MOUTH_OPEN][i] = Q6(0.1f * x);
+        m->dy[FACE_MOUTH_OPEN][i] = Q6(up ? -0.5f * b : 0.5f * b);
+
+        /* Small round "o" */
+        float oy = 0.55f * sqrtf(b);
+        m->dx[FACE_MOUTH_O][i] = Q6(0.32f * x - bx);
+        m->dy[FACE_MOUTH_O][i] = Q6((up ? -oy : oy) - by);
+
+        /* Wide clenched box with tapered corners */
+        float r = fminf(1.0f, 3.0f * (1.0f - fabsf(x)));
+        m->dx[FACE_MOUTH_GRIT][i] = Q6(0.8f * x - bx);
+        m->dy[FACE_MOUTH_GRIT][i] = Q6((up ? -0.35f * r : 0.35f * r) - by);
+    }
+}
+
+/* Eye: a squarish superellipse like the rounded-rect eye it replaces */
+static void build_eye(void)
+{
+    face_mesh_t *m = &s_eye;
+    m->verts = FACE_MESH_MAX_VERTS;
+    m->shapes = FACE_EYE_SHAPE_COUNT;
+
+    for (int i = 0; i < m->verts; i++)
+    {
+        float a = 6.2831853f * i / m->verts;
+        float c = cosf(a), s = sinf(a);
+        float x = copysignf(sqrtf(fabsf(c)), c);
+        float y = copysignf(sqrtf(fabsf(s)), s);
+
+        m->base_x[i] = Q6(x);
+        m->base_y[i] = Q6(y);
+        m->dx[FACE_EYE_CLOSE][i] = 0;
+        m->dy[FACE_EYE_CLOSE][i] = Q6(0.15f * (1.0f - x * x) - y);
+        m->dx[FACE_EYE_SQUINT][i] = 0;
+        m->dy[FACE_EYE_SQUINT][i] = Q6(y > 0 ? -0.45f * y : 0.0f);
+    }
+}
+
+static void build_tables(void)
+{
+    if (s_built)
+        return;
+    build_mouth();
+    build_eye();
+    s_built = true;
+}
+
+const face_mesh_t *face_mesh_mouth(void)
+{
+    build_tables();
+    return &s_mouth;
+}
+
+const face_mesh_t *face_mesh_eye(void)
+{
+    build_tables();
+    return &s_eye;
+}
+
+void face_mesh_eval(const face_mesh_t *mesh, const uint16_t *weights,
+                    int32_t cx, int32_t cy, int32_t hw, int32_t hh,
+                    int32_t *xs, int32_t *ys)
+{
+    int32_t ax[FACE_MESH_MAX_VERTS];
+    int32_t ay[FACE_MESH_MAX_VERTS];
+    uint32_t n = mesh->verts;
+
+    /* Q6 * Q8 accumulators; shapes with no weight cost nothing */
+    for (uint32_t i = 0; i < n; i++)
+    {
+        ax[i] = mesh->base_x[i] * FACE_MESH_ONE;
+        ay[i] = mesh->base_y[i] * FACE_MESH_ONE;
+    }
+    for (uint32_t s = 0; s < mesh->shapes; s++)
+    {
+        int32_t w = weights[s];
+        if (!w)
+            continue;
+        const int8_t *dx = mesh->dx[s];
+        const int8_t *dy = mesh->dy[s];
+        for (uint32_t i = 0; i < n; i++)
+        {
+            ax[i] += dx[i] * w;
+            ay[i] += dy[i] * w;
+        }
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        xs[i] = cx + (ax[i] * hw) / (64 * FACE_MESH_ONE);
+        ys[i] = cy + (ay[i] * hh) / (64 * FACE_MESH_ONE);
+    }
+}
@@ -0,0 +1,68 @@
+/**
+ * @file face_mesh.h
+ * @brief Blend-shape outlines for the mouth and eyes (mesh render backend)
+ *
+ * Each feature is a small closed polygon: a base outline plus per-vertex
+ * offsets for every blend shape.  A pose is the base plus the weighted sum
+ * of the offsets, so expressions morph continuously instead of snapping
+ * between hand-built shapes.  Vertices are kept in Q6 units of the
+ * feature's half extent; evaluation is integer-only, one flat loop per
+ * shape over separate x and y arrays.
+ *
+ * Internal to the lvgl_kawaii_face component.
+ */
+
+#ifndef FACE_MESH_H
+#define FACE_MESH_H
+
+#include <stdint.h>
+
+#define FACE_MESH_MAX_VERTS 16
+#define FACE_MESH_MAX_SHAPES 5
+
+/* Blend weights are Q8: 256 applies a shape fully */
+#define FACE_MESH_ONE 256
+
+typedef enum {
+    FACE_MOUTH_SMILE,
+    FACE_MOUTH_FROWN,
+    FACE_MOUTH_OPEN,
+    FACE_MOUTH_O,
+    FACE_MOUTH_GRIT,
+    FACE_MOUTH_SHAPE_COUNT
+} face_mouth_shape_t;
+
+typedef enum {
+    FACE_EYE_CLOSE,         // Lids meet on a slight downward arc
+    FACE_EYE_SQUINT,        // Lower lid pushed up, as by a smiling cheek
+    FACE_EYE_SHAPE_COUNT
+} face_eye_shape_t;
+
+typedef struct {
+    uint8_t verts;
+    uint8_t shapes;
+    int8_t base_x[FACE_MESH_MAX_VERTS];
+    int8_t base_y[FACE_MESH_MAX_VERTS];
+    int8_t dx[FACE_MESH_MAX_SHAPES][FACE_MESH_MAX_VERTS];
+    int8_t dy[FACE_MESH_MAX_SHAPES][FACE_MESH_MAX_VERTS];
+} face_mesh_t;
+
+/*
+ * Mouth outline: vertices 0..8 run along the upper lip from the left corner
+ * to the right one, 9..15 back along the lower lip.  FACE_MESH_MOUTH_LOWER_MID
+ * is the lower lip's centre vertex.
+ */
+#define FACE_MESH_MOUTH_LOWER_MID 12
+
+const face_mesh_t *face_mesh_mouth(void);
+const face_mesh_t *face_mesh_eye(void);
+
+/*
+ * Evaluate `mesh` at `weights` (Q8, one per shape) into xs/ys, in 1/16 px
+ * around (cx, cy) scaled by the half extents hw/hh (all 1/16 px).
+ */
+void face_mesh_eval(const face_mesh_t *mesh, const uint16_t *weights,
+                    int32_t cx, int32_t cy, int32_t hw, int32_t hh,
+                    int32_t *xs, int32_t *ys);
+
+#endif // FACE_MESH_H
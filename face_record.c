@@ -0,0 +1,380 @@
+/**
+ * @file face_record.c
+ * @brief Ring-buffered frame recorder writing raw RGB565 or PNG files
+ */
+
+#include "face_record.h"
+#include "face_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+static const char *TAG = "face_record";
+
+#define RECORD_DEFAULT_FRAMES 4
+#define RECORD_PREFIX_MAX 96
+#define RECORD_PATH_MAX (RECORD_PREFIX_MAX + 32)
+
+/* Largest stored deflate block */
+#define PNG_BLOCK_MAX 65535
+
+typedef struct
+{
+    uint16_t *px;
+    uint32_t seq;
+    uint32_t time_ms;
+} record_slot_t;
+
+typedef struct
+{
+    face_record_format_t format;
+    char prefix[RECORD_PREFIX_MAX];
+    uint16_t face_sz;
+    uint32_t start_tick;
+    uint32_t seq;               // LVGL context only
+
+    record_slot_t *slots;
+    uint8_t slot_count;
+    uint8_t *row_buf;           // Writer thread only: one PNG scanline
+
+    /* Ring indices and counters, under `lock` */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint8_t head;
+    uint8_t queued;
+    uint32_t written;
+    uint32_t dropped;
+    bool running;
+
+    pthread_t thread;
+    bool active;
+} record_state_t;
+
+static record_state_t s_rec;
+
+/* ------------------------------------------------------------------ */
+/* PNG writer: stored (uncompressed) deflate, so no zlib is needed     */
+/* ------------------------------------------------------------------ */
+
+typedef struct
+{
+    FILE *f;
+    uint32_t crc;
+    uint32_t adler_a;
+    uint32_t adler_b;
+    uint32_t left;              // Raw bytes still to come
+    uint32_t block_left;        // Bytes left in the current stored block
+} png_writer_t;
+
+static uint32_t crc_table[256];
+
+static void crc_init(void)
+{
+    if (crc_table[1])
+        return;
+    for (uint32_t n = 0; n < 256; n++)
+    {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crc_table[n] = c;
+    }
+}
+
+static uint32_t crc_update(uint32_t crc, const uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        crc = crc_table[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+static void put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/* Write bytes that belong to the current chunk's data */
+static void png_chunk_data(png_writer_t *w, const uint8_t *buf, size_t len)
+{
+    w->crc = crc_update(w->crc, buf, len);
+    fwrite(buf, 1, len, w->f);
+}
+
+static void png_chunk_begin(png_writer_t *w, const char *type, uint32_t len)
+{
+    uint8_t hdr[8];
+    put_be32(hdr, len);
+    memcpy(hdr + 4, type, 4);
+    fwrite(hdr, 1, 4, w->f);
+    w->crc = 0xFFFFFFFFu;
+    png_chunk_data(w, hdr + 4, 4);
+}
+
+static void png_chunk_end(png_writer_t *w)
+{
+    uint8_t crc[4];
+    put_be32(crc, w->crc ^ 0xFFFFFFFFu);
+    fwrite(crc, 1, 4, w->f);
+}
+
+/* Feed image bytes through stored deflate blocks, opening one as needed */
+static void png_idat_put(png_writer_t *w, const uint8_t *buf, uint32_t len)
+{
+    while (len)
+    {
+        if (!w->block_left)
+        {
+            uint16_t n = (uint16_t)LV_MIN(w->left, PNG_BLOCK_MAX);
+            uint8_t blk[5] = {w->left <= PNG_BLOCK_MAX, (uint8_t)n, (uint8_t)(n >> 8),
+                              (uint8_t)~n, (uint8_t)(~n >> 8)};
+            png_chunk_data(w, blk, sizeof(blk));
+            w->block_left = n;
+        }
+
+        uint32_t n = LV_MIN(len, w->block_left);
+        png_chunk_data(w, buf, n);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            w->adler_a = (w->adler_a + buf[i]) % 65521;
+            w->adler_b = (w->adler_b + w->adler_a) % 65521;
+        }
+        w->block_left -= n;
+        w->left -= n;
+        buf += n;
+        len -= n;
+    }
+}
+
+static bool write_png(FILE *f, const uint16_t *px, uint16_t size)
+{
+    static const uint8_t sig[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png_writer_t w = {.f = f, .adler_a = 1};
+
+    crc_init();
+    fwrite(sig, 1, sizeof(sig), f);
+
+    uint8_t ihdr[13] = {0};
+    put_be32(ihdr, size);
+    put_be32(ihdr + 4, size);
+    ihdr[8] = 8;        // Bit depth
+    ihdr[9] = 2;        // Truecolour
+    png_chunk_begin(&w, "IHDR", sizeof(ihdr));
+    png_chunk_data(&w, ihdr, sizeof(ihdr));
+    png_chunk_end(&w);
+
+    uint32_t row_len = 1 + (uint32_t)size * 3;
+    uint32_t raw_len = row_len * size;
+    uint32_t blocks = (raw_len + PNG_BLOCK_MAX - 1) / PNG_BLOCK_MAX;
+    png_chunk_begin(&w, "IDAT", 2 + raw_len + blocks * 5 + 4);
+
+    static const uint8_t zlib_hdr[2] = {0x78, 0x01};
+    png_chunk_data(&w, zlib_hdr, sizeof(zlib_hdr));
+    w.left = raw_len;
+
+    uint8_t *row = s_rec.row_buf;
+    for (uint16_t y = 0; y < size; y++)
+    {
+        const uint16_t *src = px + (size_t)y * size;
+        row[0] = 0;     // Filter: none
+        for (uint16_t x = 0; x < size; x++)
+        {
+            uint16_t c = src[x];
+            row[1 + x * 3] = (uint8_t)(((c >> 11) & 0x1F) * 255 / 31);
+            row[2 + x * 3] = (uint8_t)(((c >> 5) & 0x3F) * 255 / 63);
+            row[3 + x * 3] = (uint8_t)((c & 0x1F) * 255 / 31);
+        }
+        png_idat_put(&w, row, row_len);
+    }
+
+    uint8_t adler[4];
+    put_be32(adler, (w.adler_b << 16) | w.adler_a);
+    png_chunk_data(&w, adler, sizeof(adler));
+    png_chunk_end(&w);
+
+    png_chunk_begin(&w, "IEND", 0);
+    png_chunk_end(&w);
+    return !ferror(f);
+}
+
+/* ------------------------------------------------------------------ */
+/* Capture and writer thread                                           */
+/* ------------------------------------------------------------------ */
+
+/* LVGL context: copy the face into a free slot, never block on I/O */
+static void record_frame_cb(void *user_data)
+{
+    (void)user_data;
+    uint32_t seq = s_rec.seq++;
+
+    pthread_mutex_lock(&s_rec.lock);
+    bool full = s_rec.queued == s_rec.slot_count;
+    if (full)
+        s_rec.dropped++;
+    uint8_t idx = s_rec.head;
+    pthread_mutex_unlock(&s_rec.lock);
+    if (full)
+        return;
+
+    /* The writer never reads a slot before it is queued below */
+    record_slot_t *slot = &s_rec.slots[idx];
+    if (face_frame_snapshot_rgb565(slot->px) != ESP_OK)
+        return;
+    slot->seq = seq;
+    slot->time_ms = lv_tick_elaps(s_rec.start_tick);
+
+    pthread_mutex_lock(&s_rec.lock);
+    s_rec.head = (uint8_t)((idx + 1) % s_rec.slot_count);
+    s_rec.queued++;
+    pthread_cond_signal(&s_rec.cond);
+    pthread_mutex_unlock(&s_rec.lock);
+}
+
+static void write_slot(const record_slot_t *slot)
+{
+    char path[RECORD_PATH_MAX];
+    bool png = s_rec.format == FACE_RECORD_PNG;
+    snprintf(path, sizeof(path), "%s_%06lu_%08lums.%s", s_rec.prefix,
+             (unsigned long)slot->seq, (unsigned long)slot->time_ms, png ? "png" : "rgb565");
+
+    FILE *f = fopen(path, "wb");
+    if (!f)
+    {
+        FACE_LOGE(TAG, "Cannot open %s", path);
+        return;
+    }
+
+    bool ok;
+    if (png)
+    {
+        ok = write_png(f, slot->px, s_rec.face_sz);
+    }
+    else
+    {
+        size_t px = (size_t)s_rec.face_sz * s_rec.face_sz;
+        ok = fwrite(slot->px, sizeof(uint16_t), px, f) == px;
+    }
+    if (fclose(f) != 0 || !ok)
+    {
+        FACE_LOGE(TAG, "Failed writing %s", path);
+        return;
+    }
+
+    pthread_mutex_lock(&s_rec.lock);
+    s_rec.written++;
+    pthread_mutex_unlock(&s_rec.lock);
+}
+
+static void *record_thread(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&s_rec.lock);
+    for (;;)
+    {
+        while (s_rec.running && !s_rec.queued)
+            pthread_cond_wait(&s_rec.cond, &s_rec.lock);
+        if (!s_rec.queued)
+            break;
+
+        uint8_t tail = (uint8_t)((s_rec.head + s_rec.slot_count - s_rec.queued) % s_rec.slot_count);
+        pthread_mutex_unlock(&s_rec.lock);
+
+        write_slot(&s_rec.slots[tail]);
+
+        pthread_mutex_lock(&s_rec.lock);
+        s_rec.queued--;
+    }
+    pthread_mutex_unlock(&s_rec.lock);
+    return NULL;
+}
+
+static void record_free(void)
+{
+    if (s_rec.slots)
+    {
+        for (int i = 0; i < s_rec.slot_count; i++)
+            free(s_rec.slots[i].px);
+        free(s_rec.slots);
+    }
+    free(s_rec.row_buf);
+    memset(&s_rec, 0, sizeof(s_rec));
+}
+
+esp_err_t face_record_start(const face_record_config_t *config)
+{
+    uint16_t face_sz = face_get_size();
+    if (!face_sz || s_rec.active || !config || !config->path_prefix)
+        return ESP_ERR_INVALID_ARG;
+    if (!face_snapshot_supported())
+        return ESP_ERR_NOT_SUPPORTED;
+
+    s_rec.format = config->format;
+    snprintf(s_rec.prefix, sizeof(s_rec.prefix), "%s", config->path_prefix);
+    s_rec.face_sz = face_sz;
+    s_rec.slot_count = config->ring_frames ? config->ring_frames : RECORD_DEFAULT_FRAMES;
+
+    s_rec.slots = calloc(s_rec.slot_count, sizeof(record_slot_t));
+    s_rec.row_buf = malloc(1 + (size_t)face_sz * 3);
+    bool ok = s_rec.slots && s_rec.row_buf;
+    for (int i = 0; ok && i < s_rec.slot_count; i++)
+    {
+        s_rec.slots[i].px = malloc((size_t)face_sz * face_sz * sizeof(uint16_t));
+        ok = s_rec.slots[i].px != NULL;
+    }
+    if (!ok)
+    {
+        FACE_LOGE(TAG, "Failed to allocate %u-frame ring", s_rec.slot_count);
+        record_free();
+        return ESP_ERR_NO_MEM;
+    }
+
+    pthread_mutex_init(&s_rec.lock, NULL);
+    pthread_cond_init(&s_rec.cond, NULL);
+    s_rec.running = true;
+    s_rec.start_tick = lv_tick_get();
+
+    if (pthread_create(&s_rec.thread, NULL, record_thread, NULL) != 0)
+    {
+        FACE_LOGE(TAG, "Failed to start writer thread");
+        pthread_cond_destroy(&s_rec.cond);
+        pthread_mutex_destroy(&s_rec.lock);
+        record_free();
+        return ESP_FAIL;
+    }
+    s_rec.active = true;
+
+    if (face_add_frame_cb(record_frame_cb, NULL) != ESP_OK)
+    {
+        face_record_stop();
+        return ESP_ERR_NO_MEM;
+    }
+
+    FACE_LOGI(TAG, "Recording to %s_* (%u-frame ring)", s_rec.prefix, s_rec.slot_count);
+    return ESP_OK;
+}
+
+void face_record_stop(void)
+{
+    if (!s_rec.active)
+        return;
+
+    face_remove_frame_cb(record_frame_cb, NULL);
+
+    /* The writer drains the queued frames before it exits */
+    pthread_mutex_lock(&s_rec.lock);
+    s_rec.running = false;
+    pthread_cond_broadcast(&s_rec.cond);
+    pthread_mutex_unlock(&s_rec.lock);
+    pthread_join(s_rec.thread, NULL);
+
+    FACE_LOGI(TAG, "Recording stopped: %lu frames written, %lu dropped",
+              (unsigned long)s_rec.written, (unsigned long)s_rec.dropped);
+
+    pthread_cond_destroy(&s_rec.cond);
+    pthread_mutex_destroy(&s_rec.lock);
+    record_free();
+}
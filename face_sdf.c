@@ -0,0 +1,549 @@
+/**
+ * @file face_sdf.c
+ * @brief Integer signed-distance-field rasterizer for the SDF render backend
+ */
+
+#include "face_sdf.h"
+
+/* Distances are carried in 1/16 px; a pixel's coverage ramps linearly
+ * over one pixel centred on the edge. */
+#define SDF_ONE 16
+#define SDF_HALF 8
+
+/* Pixels per run: primitives fill a run's alpha first, then blend it with
+ * one kernel per colour format */
+#define SDF_ROW_MAX 512
+
+static uint8_t s_row_bg[SDF_ROW_MAX];
+static uint8_t s_row_border[SDF_ROW_MAX];
+
+typedef struct
+{
+    lv_color_t bg_color;
+    uint16_t bg_565;
+    lv_opa_t bg_opa;
+    lv_color_t border_color;
+    uint16_t border_565;
+    lv_opa_t border_opa;
+    int32_t border_w;   // 1/16 px, 0 = no border
+} sdf_paint_t;
+
+static uint32_t isqrt32(uint32_t v)
+{
+    uint32_t r = 0;
+    uint32_t b = 1u << 30;
+
+    while (b > v)
+        b >>= 2;
+    while (b)
+    {
+        if (v >= r + b)
+        {
+            v -= r + b;
+            r = (r >> 1) + b;
+        }
+        else
+        {
+            r >>= 1;
+        }
+        b >>= 2;
+    }
+    return r;
+}
+
+/*
+ * Squared-distance thresholds of the bands where d = isqrt(q2) - r changes
+ * a pixel: the outer edge's anti-aliased band and, with a border, the
+ * border's inner one.  Everywhere else a stand-in with the same coverage
+ * is returned, so the square root only runs along the edges.
+ */
+typedef struct
+{
+    int32_t r;
+    int32_t border_w;
+    uint32_t inner2;    // From here to ring2: border's inner band
+    uint32_t ring2;     // From here to edge2: border only
+    uint32_t edge2;     // From here to out2: outer band
+    uint32_t out2;      // From here on: outside
+} sdf_band_t;
+
+/* Smallest q2 whose isqrt32() is at least k */
+static inline uint32_t sq_from(int32_t k)
+{
+    return k > 0 ? (uint32_t)k * (uint32_t)k : 0;
+}
+
+static void band_init(sdf_band_t *b, int32_t r, int32_t border_w)
+{
+    b->r = r;
+    b->border_w = border_w;
+    b->edge2 = sq_from(r - SDF_HALF + 1);
+    b->out2 = sq_from(r + SDF_HALF);
+    b->inner2 = border_w ? sq_from(r - border_w - SDF_HALF + 1) : b->edge2;
+    b->ring2 = border_w ? sq_from(r - border_w + SDF_HALF) : b->edge2;
+}
+
+static inline int32_t band_dist(uint32_t q2, const sdf_band_t *b)
+{
+    if (q2 >= b->out2)
+        return SDF_HALF;
+    if (q2 >= b->edge2)
+        return (int32_t)isqrt32(q2) - b->r;
+    if (q2 >= b->ring2)
+        return -SDF_HALF;
+    if (q2 >= b->inner2)
+        return (int32_t)isqrt32(q2) - b->r;
+    return -b->border_w - SDF_ONE;
+}
+
+static inline uint32_t coverage(int32_t d)
+{
+    int32_t v = SDF_HALF - d;
+    if (v <= 0)
+        return 0;
+    if (v >= SDF_ONE)
+        return 255;
+    return (uint32_t)v * 16;
+}
+
+static inline uint16_t to_565(lv_color_t c)
+{
+    return (uint16_t)(((c.red & 0xF8) << 8) | ((c.green & 0xFC) << 3) | (c.blue >> 3));
+}
+
+static inline void blend_argb8888(uint8_t *p, lv_color_t c, uint32_t a)
+{
+    uint32_t da = p[3];
+
+    if (a >= 255 || da == 0)
+    {
+        p[0] = c.blue;
+        p[1] = c.green;
+        p[2] = c.red;
+        p[3] = (uint8_t)a;
+        return;
+    }
+
+    uint32_t keep = (da * (255 - a)) / 255;
+    uint32_t out_a = a + keep;
+    p[0] = (uint8_t)((c.blue * a + p[0] * keep) / out_a);
+    p[1] = (uint8_t)((c.green * a + p[1] * keep) / out_a);
+    p[2] = (uint8_t)((c.red * a + p[2] * keep) / out_a);
+    p[3] = (uint8_t)out_a;
+}
+
+/* Opaque 24-bit destination (RGB888, or XRGB8888 whose X byte is left) */
+static inline void blend_rgb888(uint8_t *p, lv_color_t c, uint32_t a)
+{
+    uint32_t a256 = a + (a >> 7);
+
+    p[0] = (uint8_t)(p[0] + (((int32_t)c.blue - p[0]) * (int32_t)a256 >> 8));
+    p[1] = (uint8_t)(p[1] + (((int32_t)c.green - p[1]) * (int32_t)a256 >> 8));
+    p[2] = (uint8_t)(p[2] + (((int32_t)c.red - p[2]) * (int32_t)a256 >> 8));
+}
+
+/*
+ * Blend a run of n pixels, a[i] = 0..255 weight of the colour.  The format
+ * is switched on once per run; for the opaque formats a weight of 0 leaves
+ * the pixel as it is, so their loops need no branch.
+ */
+static void blend_row(const face_sdf_target_t *t, uint8_t *p, lv_color_t c, uint16_t c565,
+                      const uint8_t *a, int32_t n)
+{
+    switch (t->cf)
+    {
+    case LV_COLOR_FORMAT_ARGB8888:
+        for (int32_t i = 0; i < n; i++)
+        {
+            if (a[i])
+                blend_argb8888(p + i * 4, c, a[i]);
+        }
+        break;
+    case LV_COLOR_FORMAT_RGB888:
+        for (int32_t i = 0; i < n; i++)
+            blend_rgb888(p + i * 3, c, a[i]);
+        break;
+    case LV_COLOR_FORMAT_XRGB8888:
+        for (int32_t i = 0; i < n; i++)
+            blend_rgb888(p + i * 4, c, a[i]);
+        break;
+    default:
+    {
+        uint16_t *px = (uint16_t *)p;
+        for (int32_t i = 0; i < n; i++)
+            px[i] = face_blend_rgb565(px[i], c565, a[i]);
+        break;
+    }
+    }
+}
+
+static inline uint32_t px_size(const face_sdf_target_t *t)
+{
+    switch (t->cf)
+    {
+    case LV_COLOR_FORMAT_ARGB8888:
+    case LV_COLOR_FORMAT_XRGB8888:
+        return 4;
+    case LV_COLOR_FORMAT_RGB888:
+        return 3;
+    default:
+        return 2;
+    }
+}
+
+static void paint_init(sdf_paint_t *paint, const lv_draw_rect_dsc_t *dsc)
+{
+    paint->bg_color = dsc->bg_color;
+    paint->bg_565 = to_565(dsc->bg_color);
+    paint->bg_opa = dsc->bg_opa;
+    paint->border_color = dsc->border_color;
+    paint->border_565 = to_565(dsc->border_color);
+    paint->border_opa = dsc->border_opa;
+    paint->border_w = (dsc->border_width > 0 && dsc->border_opa > 0) ? dsc->border_width * SDF_ONE : 0;
+}
+
+/* Weights of run pixel i: background over the whole shape, border over the
+ * ring d in [-border_w, 0] */
+static inline void shade(int32_t i, int32_t d, const sdf_paint_t *paint)
+{
+    uint32_t outer = coverage(d);
+
+    s_row_bg[i] = (uint8_t)((outer * paint->bg_opa) / 255);
+    if (paint->border_w)
+    {
+        uint32_t inner = coverage(d + paint->border_w);
+        s_row_border[i] = (uint8_t)(((outer - inner) * paint->border_opa) / 255);
+    }
+}
+
+static void shade_row(const face_sdf_target_t *t, uint8_t *p, int32_t n, const sdf_paint_t *paint)
+{
+    blend_row(t, p, paint->bg_color, paint->bg_565, s_row_bg, n);
+    if (paint->border_w)
+        blend_row(t, p, paint->border_color, paint->border_565, s_row_border, n);
+}
+
+/* Translate a local bounding box into the buffer and clip it */
+static bool prep_box(const face_sdf_target_t *t, int32_t x1, int32_t y1, int32_t x2, int32_t y2, lv_area_t *box)
+{
+    int32_t px = t->sub_x ? 1 : 0;
+    int32_t py = t->sub_y ? 1 : 0;
+
+    box->x1 = LV_MAX(x1 + t->ox - px, t->clip.x1);
+    box->y1 = LV_MAX(y1 + t->oy - py, t->clip.y1);
+    box->x2 = LV_MIN(x2 + t->ox + px, t->clip.x2);
+    box->y2 = LV_MIN(y2 + t->oy + py, t->clip.y2);
+    return box->x1 <= box->x2 && box->y1 <= box->y2;
+}
+
+void face_sdf_fill(const face_sdf_target_t *t, lv_color_t color, lv_opa_t opa)
+{
+    uint16_t c565 = to_565(color);
+
+    for (int32_t y = t->clip.y1; y <= t->clip.y2; y++)
+    {
+        uint8_t *row = t->buf + y * t->stride;
+        if (t->cf != LV_COLOR_FORMAT_RGB565)
+        {
+            uint32_t bpp = px_size(t);
+            uint8_t *p = row + t->clip.x1 * bpp;
+            for (int32_t x = t->clip.x1; x <= t->clip.x2; x++, p += bpp)
+            {
+                p[0] = color.blue;
+                p[1] = color.green;
+                p[2] = color.red;
+                if (bpp == 4)
+                    p[3] = (t->cf == LV_COLOR_FORMAT_ARGB8888) ? opa : LV_OPA_COVER;
+            }
+        }
+        else
+        {
+            uint16_t *p = (uint16_t *)row + t->clip.x1;
+            for (int32_t x = t->clip.x1; x <= t->clip.x2; x++)
+                *p++ = c565;
+        }
+    }
+}
+
+void face_sdf_rect(const face_sdf_target_t *t, const lv_draw_rect_dsc_t *dsc, const lv_area_t *area)
+{
+    lv_area_t box;
+    if (area->x2 < area->x1 || area->y2 < area->y1)
+        return;
+    if (!prep_box(t, area->x1, area->y1, area->x2, area->y2, &box))
+        return;
+
+    sdf_paint_t paint;
+    paint_init(&paint, dsc);
+
+    int32_t cx = (area->x1 + area->x2 + 1 + 2 * t->ox) * SDF_HALF + t->sub_x;
+    int32_t cy = (area->y1 + area->y2 + 1 + 2 * t->oy) * SDF_HALF + t->sub_y;
+    int32_t hw = (area->x2 - area->x1 + 1) * SDF_HALF;
+    int32_t hh = (area->y2 - area->y1 + 1) * SDF_HALF;
+    int32_t r = dsc->radius * SDF_ONE;
+    if (r > hw)
+        r = hw;
+    if (r > hh)
+        r = hh;
+
+    uint32_t bpp = px_size(t);
+    sdf_band_t band;
+    band_init(&band, r, paint.border_w);
+
+    for (int32_t y = box.y1; y <= box.y2; y++)
+    {
+        int32_t qy = LV_ABS(y * SDF_ONE + SDF_HALF - cy) - hh + r;
+
+        for (int32_t x0 = box.x1; x0 <= box.x2; x0 += SDF_ROW_MAX)
+        {
+            int32_t n = LV_MIN(box.x2 - x0 + 1, SDF_ROW_MAX);
+            for (int32_t i = 0; i < n; i++)
+            {
+                int32_t qx = LV_ABS((x0 + i) * SDF_ONE + SDF_HALF - cx) - hw + r;
+
+                if (qx > 0 && qy > 0)
+                    shade(i, band_dist((uint32_t)(qx * qx + qy * qy), &band), &paint);
+                else
+                    shade(i, LV_MAX(qx, qy) - r, &paint);
+            }
+            shade_row(t, t->buf + y * t->stride + x0 * bpp, n, &paint);
+        }
+    }
+}
+
+void face_sdf_line(const face_sdf_target_t *t, const lv_draw_line_dsc_t *dsc)
+{
+    int32_t x1 = (int32_t)dsc->p1.x, y1 = (int32_t)dsc->p1.y;
+    int32_t x2 = (int32_t)dsc->p2.x, y2 = (int32_t)dsc->p2.y;
+    int32_t pad = dsc->width / 2 + 1;
+
+    lv_area_t box;
+    if (!prep_box(t, LV_MIN(x1, x2) - pad, LV_MIN(y1, y2) - pad,
+                  LV_MAX(x1, x2) + pad, LV_MAX(y1, y2) + pad, &box))
+        return;
+
+    uint16_t c565 = to_565(dsc->color);
+    int32_t ax = (x1 + t->ox) * SDF_ONE + SDF_HALF + t->sub_x;
+    int32_t ay = (y1 + t->oy) * SDF_ONE + SDF_HALF + t->sub_y;
+    int32_t bax = (x2 - x1) * SDF_ONE;
+    int32_t bay = (y2 - y1) * SDF_ONE;
+    int64_t bb = (int64_t)bax * bax + (int64_t)bay * bay;
+    int32_t hw = dsc->width * SDF_HALF;
+    uint32_t bpp = px_size(t);
+    sdf_band_t band;
+    band_init(&band, hw, 0);
+
+    for (int32_t y = box.y1; y <= box.y2; y++)
+    {
+        int32_t pay = y * SDF_ONE + SDF_HALF - ay;
+
+        for (int32_t x0 = box.x1; x0 <= box.x2; x0 += SDF_ROW_MAX)
+        {
+            int32_t n = LV_MIN(box.x2 - x0 + 1, SDF_ROW_MAX);
+            for (int32_t i = 0; i < n; i++)
+            {
+                int32_t pax = (x0 + i) * SDF_ONE + SDF_HALF - ax;
+                int32_t h = 0;
+
+                if (bb > 0)
+                {
+                    int64_t dot = (int64_t)pax * bax + (int64_t)pay * bay;
+                    h = (int32_t)LV_CLAMP(0, (dot * 256) / bb, 256);
+                }
+
+                int32_t dx = pax - (bax * h) / 256;
+                int32_t dy = pay - (bay * h) / 256;
+                int32_t d = band_dist((uint32_t)(dx * dx + dy * dy), &band);
+                s_row_bg[i] = (uint8_t)((coverage(d) * dsc->opa) / 255);
+            }
+            blend_row(t, t->buf + y * t->stride + x0 * bpp, dsc->color, c565, s_row_bg, n);
+        }
+    }
+}
+
+void face_sdf_heart(const face_sdf_target_t *t, int32_t cx, int32_t tip_y, int32_t size,
+                    lv_color_t color, lv_opa_t opa)
+{
+    /* Quilez' exact heart: unit width ~1.2, height ~1.1, tip at origin */
+    int32_t half_w = (size * 62) / 100 + 1;
+    int32_t height = (size * 111) / 100 + 1;
+
+    lv_area_t box;
+    if (size <= 0 || !prep_box(t, cx - half_w, tip_y - height, cx + half_w, tip_y, &box))
+        return;
+
+    uint16_t c565 = to_565(color);
+    int32_t s = size * SDF_ONE;
+    int32_t ccx = (cx + t->ox) * SDF_ONE + SDF_HALF + t->sub_x;
+    int32_t tip = (tip_y + t->oy) * SDF_ONE + SDF_HALF + t->sub_y;
+    int32_t lobe_r = (s * 362) / 1024;   // sqrt(2) / 4
+    uint32_t bpp = px_size(t);
+    sdf_band_t lobe, edge;
+    band_init(&lobe, lobe_r, 0);
+    band_init(&edge, 0, 0);
+
+    for (int32_t y = box.y1; y <= box.y2; y++)
+    {
+        int32_t py = tip - (y * SDF_ONE + SDF_HALF);
+
+        for (int32_t x0 = box.x1; x0 <= box.x2; x0 += SDF_ROW_MAX)
+        {
+            int32_t n = LV_MIN(box.x2 - x0 + 1, SDF_ROW_MAX);
+            for (int32_t i = 0; i < n; i++)
+            {
+                int32_t px = LV_ABS((x0 + i) * SDF_ONE + SDF_HALF - ccx);
+                int32_t d;
+
+                if (py + px > s)
+                {
+                    int32_t dx = px - s / 4;
+                    int32_t dy = py - (3 * s) / 4;
+                    d = band_dist((uint32_t)(dx * dx + dy * dy), &lobe);
+                }
+                else
+                {
+                    /* Unsigned distance to the lower edges, sign from the side */
+                    int32_t ax = px, ay = py - s;
+                    int32_t m = LV_MAX(px + py, 0) / 2;
+                    int32_t bx = px - m, by = py - m;
+                    uint32_t a2 = (uint32_t)(ax * ax + ay * ay);
+                    uint32_t b2 = (uint32_t)(bx * bx + by * by);
+                    d = band_dist(LV_MIN(a2, b2), &edge);
+                    if (px < py)
+                        d = -d;
+                }
+
+                s_row_bg[i] = (uint8_t)((coverage(d) * opa) / 255);
+            }
+            blend_row(t, t->buf + y * t->stride + x0 * bpp, color, c565, s_row_bg, n);
+        }
+    }
+}
+
+void face_sdf_diamond(const face_sdf_target_t *t, int32_t cx, int32_t cy, int32_t half,
+                      const lv_draw_rect_dsc_t *dsc)
+{
+    lv_area_t box;
+    if (half <= 0 || !prep_box(t, cx - half - 1, cy - half - 1, cx + half + 1, cy + half + 1, &box))
+        return;
+
+    sdf_paint_t paint;
+    paint_init(&paint, dsc);
+
+    int32_t ccx = (cx + t->ox) * SDF_ONE + SDF_HALF + t->sub_x;
+    int32_t ccy = (cy + t->oy) * SDF_ONE + SDF_HALF + t->sub_y;
+    int32_t a = half * SDF_ONE;
+    uint32_t bpp = px_size(t);
+
+    for (int32_t y = box.y1; y <= box.y2; y++)
+    {
+        int32_t dy = LV_ABS(y * SDF_ONE + SDF_HALF - ccy);
+
+        for (int32_t x0 = box.x1; x0 <= box.x2; x0 += SDF_ROW_MAX)
+        {
+            int32_t n = LV_MIN(box.x2 - x0 + 1, SDF_ROW_MAX);
+            for (int32_t i = 0; i < n; i++)
+            {
+                int32_t dx = LV_ABS((x0 + i) * SDF_ONE + SDF_HALF - ccx);
+                /* |x| + |y| = a, scaled by 1/sqrt(2) to a true distance */
+                shade(i, ((dx + dy - a) * 181) >> 8, &paint);
+            }
+            shade_row(t, t->buf + y * t->stride + x0 * bpp, n, &paint);
+        }
+    }
+}
+
+/* Polygon scanline filler: SDF_POLY_SUBS sub-scanlines per pixel row, exact
+ * 1/16 px horizontal coverage, so the cost follows rows x edges */
+#define SDF_POLY_SUBS 4
+#define SDF_POLY_MAX_W SDF_ROW_MAX
+#define SDF_POLY_MAX_VERTS 32
+
+static uint8_t s_poly_cov[SDF_POLY_MAX_W];
+
+static void poly_span(int32_t xa, int32_t xb, int32_t bx1, int32_t bx2)
+{
+    xa = LV_MAX(xa, bx1 * SDF_ONE);
+    xb = LV_MIN(xb, (bx2 + 1) * SDF_ONE);
+    if (xa >= xb)
+        return;
+
+    int32_t pa = xa >> 4, pb = xb >> 4;
+    if (pa == pb)
+    {
+        s_poly_cov[pa - bx1] += (uint8_t)(xb - xa);
+        return;
+    }
+    s_poly_cov[pa - bx1] += (uint8_t)(SDF_ONE - (xa & 15));
+    for (int32_t p = pa + 1; p < pb; p++)
+        s_poly_cov[p - bx1] += SDF_ONE;
+    if (pb <= bx2)
+        s_poly_cov[pb - bx1] += (uint8_t)(xb & 15);
+}
+
+void face_sdf_polygon(const face_sdf_target_t *t, const int32_t *xs, const int32_t *ys, uint32_t n,
+                      lv_color_t color, lv_opa_t opa)
+{
+    if (n < 3 || n > SDF_POLY_MAX_VERTS || opa == 0)
+        return;
+
+    int32_t vx[SDF_POLY_MAX_VERTS], vy[SDF_POLY_MAX_VERTS];
+    int32_t dx = t->ox * SDF_ONE + t->sub_x;
+    int32_t dy = t->oy * SDF_ONE + t->sub_y;
+    int32_t x1 = INT32_MAX, y1 = INT32_MAX, x2 = INT32_MIN, y2 = INT32_MIN;
+    for (uint32_t i = 0; i < n; i++)
+    {
+        vx[i] = xs[i] + dx;
+        vy[i] = ys[i] + dy;
+        x1 = LV_MIN(x1, vx[i]);
+        x2 = LV_MAX(x2, vx[i]);
+        y1 = LV_MIN(y1, vy[i]);
+        y2 = LV_MAX(y2, vy[i]);
+    }
+
+    lv_area_t box = {
+        LV_MAX(x1 >> 4, t->clip.x1), LV_MAX(y1 >> 4, t->clip.y1),
+        LV_MIN(x2 >> 4, t->clip.x2), LV_MIN(y2 >> 4, t->clip.y2),
+    };
+    if (box.x2 - box.x1 >= SDF_POLY_MAX_W)
+        box.x2 = box.x1 + SDF_POLY_MAX_W - 1;
+    if (box.x1 > box.x2 || box.y1 > box.y2)
+        return;
+
+    uint16_t c565 = to_565(color);
+    uint32_t bpp = px_size(t);
+    int32_t cross[SDF_POLY_MAX_VERTS];
+
+    for (int32_t y = box.y1; y <= box.y2; y++)
+    {
+        for (int s = 0; s < SDF_POLY_SUBS; s++)
+        {
+            int32_t sy = y * SDF_ONE + (SDF_ONE / SDF_POLY_SUBS) * s + SDF_ONE / (2 * SDF_POLY_SUBS);
+            uint32_t nc = 0;
+
+            for (uint32_t i = 0, j = n - 1; i < n; j = i++)
+            {
+                if ((vy[i] <= sy) == (vy[j] <= sy))
+                    continue;
+                int32_t x = vx[j] + (sy - vy[j]) * (vx[i] - vx[j]) / (vy[i] - vy[j]);
+
+                /* Insertion sort: a scanline crosses only a few edges */
+                uint32_t k = nc++;
+                for (; k > 0 && cross[k - 1] > x; k--)
+                    cross[k] = cross[k - 1];
+                cross[k] = x;
+            }
+
+            for (uint32_t k = 0; k + 1 < nc; k += 2)
+                poly_span(cross[k], cross[k + 1], box.x1, box.x2);
+        }
+
+        int32_t n = box.x2 - box.x1 + 1;
+        for (int32_t i = 0; i < n; i++)
+        {
+            s_row_bg[i] = (uint8_t)((LV_MIN(s_poly_cov[i] * 4u, 255) * opa) / 255);
+            s_poly_cov[i] = 0;
+        }
+        blend_row(t, t->buf + y * t->stride + box.x1 * bpp, color, c565, s_row_bg, n);
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * @file face_sdf.h
+ * @brief Signed-distance-field rasterizer used by the SDF render backend
+ *
+ * Every primitive is an analytic distance function evaluated once per pixel
+ * inside its own bounding box, so edges are anti-aliased for free and the
+ * cost follows the shape's area rather than the number of overlapped rects.
+ * All arithmetic is integer, in 1/16 px units; square roots are only taken
+ * in the anti-aliased band along an edge.  Each row's weights are computed
+ * first and blended by one loop per colour format.
+ *
+ * Internal to the lvgl_kawaii_face component.
+ */
+
+#ifndef FACE_SDF_H
+#define FACE_SDF_H
+
+#include "lvgl.h"
+
+/**
+ * @brief Pixel buffer the primitives are blended into
+ *
+ * Supported formats are LV_COLOR_FORMAT_RGB565, RGB888, XRGB8888 and
+ * ARGB8888; the opaque ones ignore the target's alpha.
+ * Primitive coordinates are offset by (ox, oy) before clipping, which lets
+ * a part be drawn at its position inside a larger composed buffer, and by
+ * the fractional (sub_x, sub_y) so slow motion moves edges by coverage
+ * rather than in whole-pixel steps.
+ */
+typedef struct {
+    uint8_t *buf;
+    uint32_t stride;        // Bytes per row
+    lv_color_format_t cf;
+    lv_area_t clip;         // Writable area, buffer coordinates (inclusive)
+    int32_t ox;
+    int32_t oy;
+    int32_t sub_x;          // Extra sub-pixel offset, 1/16 px
+    int32_t sub_y;
+} face_sdf_target_t;
+
+/**
+ * @brief Blend two RGB565 pixels, `a` = 0..255 weight of `src`
+ *
+ * Spreads the channels into one 32-bit word so all three are mixed with a
+ * single multiply (5-bit alpha precision).
+ */
+static inline uint16_t face_blend_rgb565(uint16_t dst, uint16_t src, uint32_t a)
+{
+    uint32_t a5 = (a + 4) >> 3;
+    uint32_t d = (dst | ((uint32_t)dst << 16)) & 0x07E0F81F;
+    uint32_t s = (src | ((uint32_t)src << 16)) & 0x07E0F81F;
+
+    d = ((((s - d) * a5) >> 5) + d) & 0x07E0F81F;
+    return (uint16_t)(d | (d >> 16));
+}
+
+void face_sdf_fill(const face_sdf_target_t *t, lv_color_t color, lv_opa_t opa);
+
+/* Rounded box with optional border, same semantics as lv_draw_rect() */
+void face_sdf_rect(const face_sdf_target_t *t, const lv_draw_rect_dsc_t *dsc, const lv_area_t *area);
+
+/* Capsule (round-capped line), same semantics as lv_draw_line() */
+void face_sdf_line(const face_sdf_target_t *t, const lv_draw_line_dsc_t *dsc);
+
+/* Heart whose bottom tip sits at (cx, tip_y); roughly size x 1.1*size */
+void face_sdf_heart(const face_sdf_target_t *t, int32_t cx, int32_t tip_y, int32_t size,
+                    lv_color_t color, lv_opa_t opa);
+
+/* Square rotated 45 degrees with half-diagonal `half` and an optional border */
+void face_sdf_diamond(const face_sdf_target_t *t, int32_t cx, int32_t cy, int32_t half,
+                      const lv_draw_rect_dsc_t *dsc);
+
+/*
+ * Even-odd filled polygon with anti-aliased edges.  Vertices are in 1/16 px
+ * relative to the target origin; at most 32.  Coverage is sampled on four
+ * sub-scanlines per row, and every covered pixel is blended once however
+ * many edges pass through it.
+ */
+void face_sdf_polygon(const face_sdf_target_t *t, const int32_t *xs, const int32_t *ys, uint32_t n,
+                      lv_color_t color, lv_opa_t opa);
+
+#endif // FACE_SDF_H
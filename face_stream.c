@@ -0,0 +1,394 @@
+/**
+ * @file face_stream.c
+ * @brief Delta-encoded TCP frame stream of the composed face
+ */
+
+#include "face_stream.h"
+#include "face_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static const char *TAG = "face_stream";
+
+#define STREAM_DEFAULT_TILE 16
+#define STREAM_MIN_TILE 8
+#define STREAM_MAX_TILE 64
+#define STREAM_HDR_SIZE 14
+#define STREAM_TILE_HDR_SIZE 4
+#define STREAM_ACCEPT_POLL_MS 200
+
+typedef struct
+{
+    face_stream_config_t config;
+    uint16_t face_sz;
+    uint16_t tiles_x;
+    uint16_t tiles_y;
+
+    /* Only the server thread touches these */
+    uint16_t *cur;          // Frame being sent
+    uint16_t *prev;         // Frame the client holds
+    uint8_t *out;           // Encoded frame
+    size_t out_size;
+    int listen_fd;
+    int client_fd;
+    int64_t start_us;
+    int64_t last_send_us;
+
+    /* Shared with the LVGL context, under `lock` */
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool frame_pending;
+    bool running;
+
+    pthread_t thread;
+    bool active;
+} stream_state_t;
+
+static stream_state_t s_stream = {.listen_fd = -1, .client_fd = -1};
+
+static int64_t stream_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static inline uint8_t *put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static inline uint8_t *put_u32(uint8_t *p, uint32_t v)
+{
+    p = put_u16(p, (uint16_t)v);
+    return put_u16(p, (uint16_t)(v >> 16));
+}
+
+/* LVGL context: only note that the picture moved on */
+static void stream_frame_cb(void *user_data)
+{
+    (void)user_data;
+    pthread_mutex_lock(&s_stream.lock);
+    s_stream.frame_pending = true;
+    pthread_cond_signal(&s_stream.cond);
+    pthread_mutex_unlock(&s_stream.lock);
+}
+
+static bool tile_changed(uint16_t x0, uint16_t y0, uint16_t w, uint16_t h)
+{
+    uint16_t face_sz = s_stream.face_sz;
+    for (uint16_t y = y0; y < y0 + h; y++)
+    {
+        size_t off = (size_t)y * face_sz + x0;
+        if (memcmp(s_stream.cur + off, s_stream.prev + off, w * sizeof(uint16_t)) != 0)
+            return true;
+    }
+    return false;
+}
+
+/* RLE one tile into `p`, return the end */
+static uint8_t *encode_tile(uint8_t *p, uint16_t x0, uint16_t y0, uint16_t w, uint16_t h)
+{
+    uint16_t face_sz = s_stream.face_sz;
+    uint16_t run_px = 0;
+    uint32_t run_len = 0;
+
+    for (uint16_t y = y0; y < y0 + h; y++)
+    {
+        const uint16_t *row = s_stream.cur + (size_t)y * face_sz;
+        for (uint16_t x = x0; x < x0 + w; x++)
+        {
+            if (run_len && (row[x] != run_px || run_len == 256))
+            {
+                *p++ = (uint8_t)(run_len - 1);
+                p = put_u16(p, run_px);
+                run_len = 0;
+            }
+            run_px = row[x];
+            run_len++;
+        }
+    }
+    *p++ = (uint8_t)(run_len - 1);
+    return put_u16(p, run_px);
+}
+
+/* Encode `cur` against `prev` into `out`; returns the byte count, or 0 if
+ * no tile changed */
+static size_t encode_frame(bool key)
+{
+    uint8_t tile = s_stream.config.tile_size;
+    uint16_t face_sz = s_stream.face_sz;
+    uint8_t *p = s_stream.out + STREAM_HDR_SIZE;
+    uint16_t count = 0;
+
+    for (uint16_t ty = 0; ty < s_stream.tiles_y; ty++)
+    {
+        for (uint16_t tx = 0; tx < s_stream.tiles_x; tx++)
+        {
+            uint16_t x0 = tx * tile, y0 = ty * tile;
+            uint16_t w = LV_MIN(tile, face_sz - x0);
+            uint16_t h = LV_MIN(tile, face_sz - y0);
+            if (!key && !tile_changed(x0, y0, w, h))
+                continue;
+
+            uint8_t *hdr = p;
+            p = encode_tile(p + STREAM_TILE_HDR_SIZE, x0, y0, w, h);
+            put_u16(hdr, (uint16_t)(ty * s_stream.tiles_x + tx));
+            put_u16(hdr + 2, (uint16_t)(p - hdr - STREAM_TILE_HDR_SIZE));
+            count++;
+        }
+    }
+    if (!count)
+        return 0;
+
+    uint8_t *h = s_stream.out;
+    *h++ = 'K';
+    *h++ = 'F';
+    *h++ = key ? 1 : 0;
+    *h++ = tile;
+    h = put_u16(h, face_sz);
+    h = put_u16(h, face_sz);
+    h = put_u32(h, (uint32_t)((stream_time_us() - s_stream.start_us) / 1000));
+    put_u16(h, count);
+    return (size_t)(p - s_stream.out);
+}
+
+static bool send_all(int fd, const uint8_t *buf, size_t len)
+{
+    while (len)
+    {
+        ssize_t n = send(fd, buf, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void drop_client(void)
+{
+    if (s_stream.client_fd >= 0)
+    {
+        close(s_stream.client_fd);
+        s_stream.client_fd = -1;
+        FACE_LOGI(TAG, "Client disconnected");
+    }
+}
+
+/* Wait up to STREAM_ACCEPT_POLL_MS for a client */
+static void accept_client(void)
+{
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(s_stream.listen_fd, &fds);
+    struct timeval tv = {.tv_sec = 0, .tv_usec = STREAM_ACCEPT_POLL_MS * 1000};
+    if (select(s_stream.listen_fd + 1, &fds, NULL, NULL, &tv) <= 0)
+        return;
+
+    int fd = accept(s_stream.listen_fd, NULL, NULL);
+    if (fd < 0)
+        return;
+
+    s_stream.client_fd = fd;
+    FACE_LOGI(TAG, "Client connected");
+
+    /* Force a keyframe even if the face is standing still */
+    pthread_mutex_lock(&s_stream.lock);
+    s_stream.frame_pending = true;
+    pthread_mutex_unlock(&s_stream.lock);
+}
+
+static void *stream_thread(void *arg)
+{
+    (void)arg;
+    bool key = true;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&s_stream.lock);
+        bool running = s_stream.running;
+        pthread_mutex_unlock(&s_stream.lock);
+        if (!running)
+            break;
+
+        if (s_stream.client_fd < 0)
+        {
+            accept_client();
+            key = true;
+            continue;
+        }
+
+        pthread_mutex_lock(&s_stream.lock);
+        while (s_stream.running && !s_stream.frame_pending)
+            pthread_cond_wait(&s_stream.cond, &s_stream.lock);
+        s_stream.frame_pending = false;
+        pthread_mutex_unlock(&s_stream.lock);
+
+        /* Sleep off the rest of the frame slot, then take the latest face */
+        if (s_stream.config.max_fps)
+        {
+            int64_t due = s_stream.last_send_us + 1000000 / s_stream.config.max_fps;
+            int64_t wait = due - stream_time_us();
+            if (wait > 0)
+                usleep((useconds_t)wait);
+        }
+
+        if (face_snapshot_rgb565(s_stream.cur) != ESP_OK)
+            continue;
+        s_stream.last_send_us = stream_time_us();
+
+        size_t len = encode_frame(key);
+        if (!len)
+            continue;
+        if (!send_all(s_stream.client_fd, s_stream.out, len))
+        {
+            drop_client();
+            continue;
+        }
+        key = false;
+
+        uint16_t *t = s_stream.prev;
+        s_stream.prev = s_stream.cur;
+        s_stream.cur = t;
+    }
+
+    drop_client();
+    return NULL;
+}
+
+static int open_listener(void)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(s_stream.config.port);
+    addr.sin_addr.s_addr = htonl(s_stream.config.loopback_only ? INADDR_LOOPBACK : INADDR_ANY);
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 1) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void stream_free(void)
+{
+    if (s_stream.listen_fd >= 0)
+        close(s_stream.listen_fd);
+    free(s_stream.cur);
+    free(s_stream.prev);
+    free(s_stream.out);
+    memset(&s_stream, 0, sizeof(s_stream));
+    s_stream.listen_fd = -1;
+    s_stream.client_fd = -1;
+}
+
+esp_err_t face_stream_start(const face_stream_config_t *config)
+{
+    uint16_t face_sz = face_get_size();
+    if (!face_sz || s_stream.active)
+        return ESP_ERR_INVALID_ARG;
+    if (!face_snapshot_supported())
+        return ESP_ERR_NOT_SUPPORTED;
+
+    if (config)
+        s_stream.config = *config;
+    if (!s_stream.config.port)
+        s_stream.config.port = FACE_STREAM_DEFAULT_PORT;
+    if (!s_stream.config.tile_size)
+        s_stream.config.tile_size = STREAM_DEFAULT_TILE;
+    s_stream.config.tile_size = LV_CLAMP(STREAM_MIN_TILE, s_stream.config.tile_size, STREAM_MAX_TILE);
+
+    uint8_t tile = s_stream.config.tile_size;
+    s_stream.face_sz = face_sz;
+    s_stream.tiles_x = (face_sz + tile - 1) / tile;
+    s_stream.tiles_y = s_stream.tiles_x;
+
+    /* Worst case every run is a single pixel: 3 B/px plus headers */
+    size_t px = (size_t)face_sz * face_sz;
+    s_stream.out_size = STREAM_HDR_SIZE + (size_t)s_stream.tiles_x * s_stream.tiles_y * STREAM_TILE_HDR_SIZE + px * 3;
+    s_stream.cur = malloc(px * sizeof(uint16_t));
+    s_stream.prev = malloc(px * sizeof(uint16_t));
+    s_stream.out = malloc(s_stream.out_size);
+    if (!s_stream.cur || !s_stream.prev || !s_stream.out)
+    {
+        FACE_LOGE(TAG, "Failed to allocate stream buffers");
+        stream_free();
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_stream.listen_fd = open_listener();
+    if (s_stream.listen_fd < 0)
+    {
+        FACE_LOGE(TAG, "Failed to listen on port %u", s_stream.config.port);
+        stream_free();
+        return ESP_FAIL;
+    }
+
+    pthread_mutex_init(&s_stream.lock, NULL);
+    pthread_cond_init(&s_stream.cond, NULL);
+    s_stream.running = true;
+    s_stream.start_us = stream_time_us();
+
+    if (pthread_create(&s_stream.thread, NULL, stream_thread, NULL) != 0)
+    {
+        FACE_LOGE(TAG, "Failed to start stream thread");
+        pthread_cond_destroy(&s_stream.cond);
+        pthread_mutex_destroy(&s_stream.lock);
+        stream_free();
+        return ESP_FAIL;
+    }
+    s_stream.active = true;
+
+    if (face_add_frame_cb(stream_frame_cb, NULL) != ESP_OK)
+    {
+        face_stream_stop();
+        return ESP_ERR_NO_MEM;
+    }
+    FACE_LOGI(TAG, "Streaming on port %u (%u px tiles)", s_stream.config.port, tile);
+    return ESP_OK;
+}
+
+void face_stream_stop(void)
+{
+    if (!s_stream.active)
+        return;
+
+    face_remove_frame_cb(stream_frame_cb, NULL);
+
+    pthread_mutex_lock(&s_stream.lock);
+    s_stream.running = false;
+    pthread_cond_broadcast(&s_stream.cond);
+    pthread_mutex_unlock(&s_stream.lock);
+    pthread_join(s_stream.thread, NULL);
+
+    pthread_cond_destroy(&s_stream.cond);
+    pthread_mutex_destroy(&s_stream.lock);
+    stream_free();
+
+    FACE_LOGI(TAG, "Streaming stopped");
+}
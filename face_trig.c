@@ -0,0 +1,39 @@
+/**
+ * @file face_trig.c
+ * @brief Quarter-wave sine table
+ */
+
+#include "face_trig.h"
+
+/* sin over the first quadrant in 64 steps, Q15 */
+static const int16_t s_quarter[65] = {
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767,
+};
+
+/*
+ * The top two bits pick the quadrant; the odd quadrants read the table
+ * backwards and the lower half-turn is negated.  Interpolating linearly
+ * between entries keeps the result within 3 LSB of sin().
+ */
+int16_t face_sin_q15(uint16_t phase)
+{
+    uint32_t x = phase & 0x3fff;
+    if (phase & 0x4000)
+        x = 0x4000 - x;
+
+    uint32_t i = x >> 8;
+    int32_t f = x & 0xff;
+    int32_t v = s_quarter[i];
+    if (f)
+        v += ((s_quarter[i + 1] - v) * f + 128) >> 8;
+
+    return (phase & 0x8000) ? (int16_t)-v : (int16_t)v;
+}
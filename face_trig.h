@@ -0,0 +1,31 @@
+/**
+ * @file face_trig.h
+ * @brief Q15 sine and cosine from one shared quarter-wave table
+ *
+ * Angles are fractions of a turn in 16 bits (65536 = 360 degrees), so
+ * phases wrap for free in unsigned arithmetic.  Integer only: no soft-float
+ * library calls on FPU-less chips, and the same result on every platform.
+ *
+ * Internal to the lvgl_kawaii_face component.
+ */
+
+#ifndef FACE_TRIG_H
+#define FACE_TRIG_H
+
+#include <stdint.h>
+
+/* sin(90 degrees) */
+#define FACE_TRIG_ONE 32767
+
+/* Whole degrees (negative too) to a turn phase */
+#define FACE_TRIG_DEG(d) ((uint16_t)((int32_t)(d) * 65536 / 360))
+
+/* sin(phase) in Q15, linearly interpolated between table entries */
+int16_t face_sin_q15(uint16_t phase);
+
+static inline int16_t face_cos_q15(uint16_t phase)
+{
+    return face_sin_q15((uint16_t)(phase + 0x4000));
+}
+
+#endif // FACE_TRIG_H
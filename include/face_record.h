@@ -0,0 +1,60 @@
+/**
+ * @file face_record.h
+ * @brief Debug recorder that dumps every rendered face frame to files
+ *
+ * Each frame the face presents is composed into the next slot of a ring
+ * allocated up front, and a writer thread saves the slots as
+ *
+ *   <prefix>_<seq>_<time>ms.rgb565   raw little-endian RGB565, size x size
+ *   <prefix>_<seq>_<time>ms.png      24-bit PNG (uncompressed deflate)
+ *
+ * `time` counts LVGL ticks since face_record_start() and `seq` counts
+ * every presented frame, so a gap in the sequence marks frames dropped
+ * because the writer fell a whole ring behind.  The LVGL context neither
+ * allocates nor touches files; it only copies the canvases into the ring.
+ */
+
+#ifndef FACE_RECORD_H
+#define FACE_RECORD_H
+
+#include "lvgl_kawaii_face.h"
+
+/**
+ * @brief Output file format
+ */
+typedef enum {
+    FACE_RECORD_RAW,       // One .rgb565 file per frame
+    FACE_RECORD_PNG,       // One .png file per frame
+} face_record_format_t;
+
+/**
+ * @brief Recorder configuration
+ */
+typedef struct {
+    const char *path_prefix;        // e.g. "/sdcard/face" or "/tmp/face"
+    face_record_format_t format;
+    uint8_t ring_frames;            // Frames buffered for the writer, 0 = 4
+} face_record_config_t;
+
+/**
+ * @brief Start recording the running face
+ *
+ * Call after face_animation_init().  Allocates `ring_frames` face-sized
+ * RGB565 frames, starts the writer thread and adds a face frame callback.
+ *
+ * @param config Configuration (path_prefix is required)
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG if the face is not
+ *         initialised, already recording or no prefix was given,
+ *         ESP_ERR_NOT_SUPPORTED in direct-panel and LED-matrix modes,
+ *         ESP_ERR_NO_MEM, or ESP_FAIL if the thread could not start
+ */
+esp_err_t face_record_start(const face_record_config_t *config);
+
+/**
+ * @brief Stop capturing, write out the frames still queued and free the ring
+ *
+ * Call before face_animation_deinit().
+ */
+void face_record_stop(void);
+
+#endif // FACE_RECORD_H
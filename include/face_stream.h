@@ -0,0 +1,67 @@
+/**
+ * @file face_stream.h
+ * @brief Optional TCP server that streams the composed face for monitoring
+ *
+ * One client at a time receives the face as shown on the panel.  The first
+ * frame after connecting is a keyframe; each later frame carries only the
+ * tiles that changed since the previous one, every tile run-length encoded.
+ * A face that only blinks costs a few hundred bytes per frame instead of
+ * the full face_sz^2 * 2.
+ *
+ * Wire format (all integers little-endian):
+ *
+ *   frame:  "KF"  u8 flags  u8 tile  u16 width  u16 height
+ *           u32 time_ms  u16 tile_count  tile[tile_count]
+ *   tile:   u16 index  u16 len  run[]          (len = bytes of runs)
+ *   run:    u8 count-1  u16 rgb565
+ *
+ * flags bit 0 marks a keyframe.  Tiles are numbered row-major across the
+ * frame, `tile` px square (edge tiles are clipped), and their pixels are
+ * run-length coded row-major inside the tile.
+ *
+ * examples/stream_client holds a host decoder for testing over loopback.
+ */
+
+#ifndef FACE_STREAM_H
+#define FACE_STREAM_H
+
+#include "lvgl_kawaii_face.h"
+
+#define FACE_STREAM_DEFAULT_PORT 5515
+
+/**
+ * @brief Stream server configuration
+ */
+typedef struct {
+    uint16_t port;          // TCP port, 0 = FACE_STREAM_DEFAULT_PORT
+    uint8_t tile_size;      // Tile edge in px, 0 = 16
+    uint8_t max_fps;        // Frames sent per second at most, 0 = every frame
+    bool loopback_only;     // Bind to 127.0.0.1 instead of all interfaces
+} face_stream_config_t;
+
+/**
+ * @brief Start serving frames of the running face
+ *
+ * Call after face_animation_init().  Allocates two face-sized RGB565
+ * buffers, starts a server thread and adds a face frame callback.  The
+ * LVGL context only flags new frames; the server thread copies the face
+ * itself under the LVGL lock, at most max_fps times a second and only
+ * while a client is connected.  Off ESP-IDF this needs
+ * face_set_lvgl_lock_fns().
+ *
+ * @param config Configuration, NULL for defaults
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG if the face is not
+ *         initialised or already streaming, ESP_ERR_NOT_SUPPORTED in
+ *         direct-panel and LED-matrix modes, ESP_ERR_NO_MEM, or ESP_FAIL
+ *         if the socket could not be opened
+ */
+esp_err_t face_stream_start(const face_stream_config_t *config);
+
+/**
+ * @brief Stop the server, drop the client and free the buffers
+ *
+ * Call before face_animation_deinit().
+ */
+void face_stream_stop(void);
+
+#endif // FACE_STREAM_H
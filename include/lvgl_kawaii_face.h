@@ -24,6 +24,8 @@
 #    define ESP_OK          ((esp_err_t) 0)
 #    define ESP_FAIL        ((esp_err_t)-1)
 #    define ESP_ERR_NO_MEM  ((esp_err_t) 0x101)
+#    define ESP_ERR_INVALID_ARG ((esp_err_t) 0x102)
+#    define ESP_ERR_NOT_SUPPORTED ((esp_err_t) 0x106)
 #  endif
 #endif
 
@@ -52,6 +54,84 @@ typedef enum {
     FACE_EMOTION_COUNT
 } face_emotion_t;
 
+/**
+ * @brief Canvas pixel format used to render the face
+ */
+typedef enum {
+    FACE_RENDER_RGB565,    // Full-colour RGB565 canvases (default)
+    FACE_RENDER_MONO,      // 1-bpp I1 canvases, ordered-dithered (SSD1306, e-paper)
+    FACE_RENDER_ARGB8888,  // Transparent, 4 B/px, rendered in place
+    FACE_RENDER_RGB565A8,  // Transparent, 3 B/px, cheaper to blend on RGB565 panels
+    FACE_RENDER_RGB888,    // Opaque 3 B/px, for RGB888 displays
+    FACE_RENDER_XRGB8888,  // Opaque 4 B/px, for XRGB8888 / ARGB8888 displays
+    FACE_RENDER_RGB565_SWAPPED, // Byte-swapped RGB565 for SPI panels (LVGL >= 9.3)
+    FACE_RENDER_NATIVE,    // One of the opaque modes above, from the display's format at init
+} face_render_mode_t;
+
+/**
+ * @brief When rendered frames are pushed to the canvases
+ */
+typedef enum {
+    FACE_UPDATE_CONTINUOUS, // Redraw on every animation step (default)
+    FACE_UPDATE_KEYFRAMES,  // Redraw only on emotion changes and blinks (e-paper)
+} face_update_policy_t;
+
+/**
+ * @brief Rasterizer used to draw the facial features
+ */
+typedef enum {
+    FACE_BACKEND_LVGL,     // LVGL draw tasks (lv_draw_rect / lv_draw_line), default
+    FACE_BACKEND_SDF,      // Built-in anti-aliased signed-distance-field rasterizer
+    FACE_BACKEND_MESH,     // SDF, with mouth and eye outlines morphed from blend-shape meshes
+} face_backend_t;
+
+/**
+ * @brief How smooth emotion changes are animated
+ */
+typedef enum {
+    FACE_TRANSITION_PARAMETRIC, // Re-render every step at an interpolated pose (default)
+    FACE_TRANSITION_CROSSFADE,  // Render both endpoints once, then blend the cached frames
+} face_transition_t;
+
+/**
+ * @brief Changed-region callback
+ *
+ * Called from the LVGL context after a canvas has been redrawn, once per
+ * canvas, with the area that actually changed in display coordinates.
+ * Partial-refresh panels can use it to update only that window.
+ */
+typedef void (*face_region_cb_t)(const lv_area_t *area, void *user_data);
+
+/**
+ * @brief Frame callback
+ *
+ * Called from the LVGL context after an animation step changed at least
+ * one canvas, i.e. once per new frame on screen.  The LVGL lock is held
+ * while it runs; copy the face with face_frame_snapshot_rgb565().
+ */
+typedef void (*face_frame_cb_t)(void *user_data);
+
+/**
+ * @brief Direct-panel flush callback
+ *
+ * Called from the LVGL context with one finished strip of the face: `px`
+ * holds the pixels of `area` (panel coordinates) row by row, RGB565 or
+ * RGB565_SWAPPED.  Start the transfer (e.g. DMA) and return; call
+ * face_panel_flush_ready() once it has completed, possibly from an ISR.
+ * Strips complete in the order they were handed over.
+ */
+typedef void (*face_panel_flush_cb_t)(const lv_area_t *area, const uint8_t *px, void *user_data);
+
+/**
+ * @brief LED-matrix flush callback
+ *
+ * Called with each new matrix frame: width x height RGB888 pixels (R, G, B
+ * bytes, row-major, no padding, serpentine wiring is up to the callback).
+ * `rgb` stays valid and unchanged until the next call.
+ */
+typedef void (*face_matrix_flush_cb_t)(const uint8_t *rgb, uint16_t width, uint16_t height,
+                                       void *user_data);
+
 /**
  * @brief Face animation configuration
  *
@@ -85,12 +165,43 @@ typedef enum {
  *
  * All internal canvas dimensions are derived automatically from the
  * parent object's size, so proportions stay correct at any resolution.
+ *
+ * Fields after auto_blink are optional; leaving them zero keeps the
+ * default full-colour, continuously animated behaviour.
  */
 typedef struct {
     lv_obj_t *parent;          // LVGL parent object  (NULL = active screen)
-    uint32_t animation_speed;  // Animation update interval in ms
+    uint32_t animation_speed;  // Animation update interval in ms (the pace follows elapsed time)
     uint32_t blink_interval;   // Auto-blink interval in ms
     bool     auto_blink;       // Enable automatic blinking
+
+    face_render_mode_t   render_mode;         // Canvas pixel format
+    face_update_policy_t update_policy;       // Continuous or keyframes only
+    face_region_cb_t     region_cb;           // Changed-region callback (may be NULL)
+    void                *region_cb_user_data; // Passed through to region_cb
+    face_backend_t       backend;             // Feature rasterizer
+    face_transition_t    transition;          // Smooth-transition style
+    uint8_t              invalidate_align;    // Round invalidated areas to N px (AMOLED: 2), 0 = off
+    uint32_t             render_budget_us;    // Max render time per tick, 0 = whole frame per tick
+    uint8_t              lookahead_frames;    // Frames face_prerender_idle() may render ahead (max 4), 0 = off
+    bool                 sync_to_refresh;     // Step on the display's refresh instead of a timer
+
+    /* Direct-panel output: with panel_flush_cb set no LVGL objects are
+     * created and the face is streamed to the panel in strips instead */
+    face_panel_flush_cb_t panel_flush_cb;     // Strip transfer (NULL = draw through LVGL canvases)
+    void                *panel_user_data;     // Passed through to panel_flush_cb
+    uint16_t             panel_size;          // Face edge in px (parent is ignored)
+    int16_t              panel_x;             // Face top-left on the panel
+    int16_t              panel_y;
+    uint16_t             panel_strip_rows;    // Rows per strip buffer, 0 = 16
+
+    /* LED-matrix output: with matrix_flush_cb set the face is drawn at
+     * matrix resolution without any LVGL call; the application drives it
+     * with face_animation_update() every animation_speed ms */
+    face_matrix_flush_cb_t matrix_flush_cb;   // Frame transfer (NULL = no matrix)
+    void                *matrix_user_data;    // Passed through to matrix_flush_cb
+    uint16_t             matrix_width;        // LEDs per row
+    uint16_t             matrix_height;       // LED rows
 } face_config_t;
 
 /**
@@ -135,12 +246,71 @@ void face_set_emotion(face_emotion_t emotion, bool smooth);
  */
 face_emotion_t face_get_emotion(void);
 
+/**
+ * @brief Render a still thumbnail of an emotion
+ *
+ * Draws the emotion's resting pose at size x size into a newly allocated
+ * RGB565 buffer, ready for lv_image_set_src().  Uses the SDF rasterizer
+ * directly: no timer, canvas or running face is needed, and a live face
+ * is not disturbed.
+ *
+ *   lv_image_dsc_t icon;
+ *   face_render_thumbnail(FACE_HAPPY, 48, &icon);
+ *   lv_image_set_src(img, &icon);
+ *
+ * @param emotion Emotion to draw
+ * @param size    Edge length in px (>= 32)
+ * @param dsc     Filled in on success; release with face_free_thumbnail()
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG or ESP_ERR_NO_MEM
+ */
+esp_err_t face_render_thumbnail(face_emotion_t emotion, uint16_t size, lv_image_dsc_t *dsc);
+
+/**
+ * @brief Release the pixel buffer of a thumbnail
+ *
+ * The image must no longer be displayed.
+ */
+void face_free_thumbnail(lv_image_dsc_t *dsc);
+
 /**
  * @brief Update face animation (called by timer)
  * This handles smooth transitions and automatic blinking
+ *
+ * With LED-matrix output there is no timer: call this every
+ * animation_speed ms from the application's own loop.
  */
 void face_animation_update(void);
 
+/**
+ * @brief Matrix flush callback that prints the frame as coloured text
+ *
+ * Stand-in for real LEDs on a host or over a serial console: two pixel
+ * rows per line as 24-bit ANSI half blocks, to `user_data` (a FILE *) or
+ * stdout if NULL.
+ */
+void face_matrix_dump(const uint8_t *rgb, uint16_t width, uint16_t height, void *user_data);
+
+/**
+ * @brief Pre-render upcoming frames while the CPU is otherwise idle
+ *
+ * The animation is deterministic, so the frames after the current one can
+ * be rendered early into a ring of `lookahead_frames` slots.  The timer
+ * then only copies the next ready frame to the canvases, which keeps
+ * frame times flat while other UI work competes for the LVGL task.  A
+ * frame that no longer matches (emotion change, custom openness, a blink
+ * landing on a different tick) is discarded and the face renders on
+ * demand, as it does whenever the ring is empty.
+ *
+ * Call it from a low-priority task or the main loop's spare time; it takes
+ * the LVGL lock.  Needs a mode the canvases render in directly
+ * (FACE_RENDER_RGB565, FACE_RENDER_RGB888 or FACE_RENDER_XRGB8888),
+ * continuous updates and no render budget.
+ *
+ * @param budget_us Stop starting new frames after this much time
+ * @return uint8_t Frames now ready in the ring
+ */
+uint8_t face_prerender_idle(uint32_t budget_us);
+
 /**
  * @brief Set custom eye openness (0-100)
  * 
@@ -170,7 +340,10 @@ void face_trigger_blink(void);
 
 /**
  * @brief Set the position of the face on screen
- * 
+ *
+ * In direct-panel mode this moves the face on the panel and redraws it
+ * there; clearing the old area is up to the application.
+ *
  * @param x X coordinate for center of face
  * @param y Y coordinate for center of face
  */
@@ -184,9 +357,88 @@ void face_set_position(int16_t x, int16_t y);
  *   lv_obj_set_pos(face_get_container(), x, y);
  *
  * @return lv_obj_t* Pointer to the face container, or NULL if not initialised
+ *         or in direct-panel mode
  */
 lv_obj_t *face_get_container(void);
 
+/**
+ * @brief Edge length of the square face in px, 0 if not initialised
+ */
+uint16_t face_get_size(void);
+
+/**
+ * @brief Add a frame callback
+ *
+ * Up to four callbacks are kept (face_stream and face_record use one
+ * each).  The next step reports a frame even if nothing changed, so a new
+ * listener starts from a known picture.
+ *
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG for a NULL callback, or
+ *         ESP_ERR_NO_MEM if all slots are taken
+ */
+esp_err_t face_add_frame_cb(face_frame_cb_t cb, void *user_data);
+
+/**
+ * @brief Remove a callback added with face_add_frame_cb()
+ */
+void face_remove_frame_cb(face_frame_cb_t cb, void *user_data);
+
+/**
+ * @brief Whether the face can be copied with face_snapshot_rgb565()
+ *
+ * False before face_animation_init() and in direct-panel and LED-matrix
+ * modes, where the face is never held in full.
+ */
+bool face_snapshot_supported(void);
+
+/**
+ * @brief Copy the face as shown into an RGB565 buffer
+ *
+ * Composes the canvases at their positions over white, whatever the render
+ * mode.  Takes the LVGL lock, so call it from another task; a frame
+ * callback already holds the lock and uses face_frame_snapshot_rgb565().
+ *
+ * @param buf face_get_size() x face_get_size() pixels
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG if not initialised, or
+ *         ESP_ERR_NOT_SUPPORTED in direct-panel and LED-matrix modes
+ */
+esp_err_t face_snapshot_rgb565(uint16_t *buf);
+
+/**
+ * @brief face_snapshot_rgb565() for use inside a frame callback
+ *
+ * Does not take the LVGL lock, which the callback's caller already holds;
+ * taking it again would deadlock a non-recursive lock installed with
+ * face_set_lvgl_lock_fns().
+ */
+esp_err_t face_frame_snapshot_rgb565(uint16_t *buf);
+
+/**
+ * @brief Report that the oldest strip handed to panel_flush_cb is sent
+ *
+ * Only sets a flag, so it may be called from the transfer-done ISR.
+ */
+void face_panel_flush_ready(void);
+
+/**
+ * @brief Show the face a second time under another parent
+ *
+ * Creates a face-sized container under `parent` (centred) holding lv_image
+ * views of the live canvases.  Nothing is rendered twice: the images share
+ * the canvases' pixel buffers and are invalidated together with them, so
+ * the parent may live on a different LVGL display (e.g. a rear panel).
+ * Up to four mirrors can be attached.
+ *
+ * @param parent Parent object for the mirror
+ * @return lv_obj_t* The mirror container (move it like any object), or NULL
+ */
+lv_obj_t *face_add_mirror(lv_obj_t *parent);
+
+/**
+ * @brief Delete a mirror created by face_add_mirror()
+ */
+void face_remove_mirror(lv_obj_t *mirror);
+
 /**
  * @brief Clean up face animation resources
  */
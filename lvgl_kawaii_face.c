@@ -4,19 +4,16 @@
  */
 
 #include "lvgl_kawaii_face.h"
+#include "face_sdf.h"
+#include "face_mesh.h"
+#include "face_matrix.h"
+#include "face_trig.h"
+#include "face_log.h"
 #include <stdlib.h>
-#include <math.h>
+#include <string.h>
 
 #ifdef ESP_PLATFORM
-#include "esp_log.h"
-#define FACE_LOGI(tag, ...) ESP_LOGI(tag, __VA_ARGS__)
-#define FACE_LOGE(tag, ...) ESP_LOGE(tag, __VA_ARGS__)
-#define FACE_LOGW(tag, ...) ESP_LOGW(tag, __VA_ARGS__)
-#else
-#include <stdio.h>
-#define FACE_LOGI(tag, fmt, ...) printf("[I][%s] " fmt "\n", tag, ##__VA_ARGS__)
-#define FACE_LOGE(tag, fmt, ...) printf("[E][%s] " fmt "\n", tag, ##__VA_ARGS__)
-#define FACE_LOGW(tag, fmt, ...) printf("[W][%s] " fmt "\n", tag, ##__VA_ARGS__)
+#include "sdkconfig.h"
 #endif
 
 #if defined(ESP_PLATFORM) && __has_include("esp_heap_caps.h")
@@ -36,9 +33,50 @@ static inline void *face_malloc_canvas(size_t size)
     return malloc(size);
 }
 #define FACE_MALLOC_CANVAS(size) face_malloc_canvas(size)
+#define FACE_MALLOC_INTERNAL(size) heap_caps_malloc((size), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#if __has_include("esp_memory_utils.h")
+#include "esp_memory_utils.h"
+#define FACE_PTR_IN_PSRAM(p) esp_ptr_external_ram(p)
+#endif
 #else
 #define FACE_MALLOC_DMA(size) malloc(size)
 #define FACE_MALLOC_CANVAS(size) malloc(size)
+#define FACE_MALLOC_INTERNAL(size) malloc(size)
+#endif
+
+#ifndef FACE_PTR_IN_PSRAM
+#define FACE_PTR_IN_PSRAM(p) false
+#endif
+
+/* Rows of the internal-RAM band that PSRAM canvases are rendered through */
+#ifndef FACE_TILE_ROWS
+#define FACE_TILE_ROWS 16
+#endif
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+static int64_t face_time_us(void)
+{
+    return esp_timer_get_time();
+}
+#else
+#include <time.h>
+static int64_t face_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+#endif
+
+/* Panel strip completions: face_panel_flush_ready() gives the semaphore,
+ * so a renderer waiting on the wire sleeps until exactly that moment */
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+static SemaphoreHandle_t s_panel_sem;
+#else
+#include <sched.h>
 #endif
 
 #if defined(ESP_PLATFORM) && __has_include("esp_lvgl_port.h")
@@ -53,18 +91,21 @@ static inline void *face_malloc_canvas(size_t size)
 static void (*s_face_lock_fn)(void) = NULL;
 static void (*s_face_unlock_fn)(void) = NULL;
 
+/* Set for LED-matrix output, where LVGL (and its port lock) may not run */
+static bool s_face_headless;
+
 static void face_lock(void)
 {
     if (s_face_lock_fn)
         s_face_lock_fn();
-    else
+    else if (!s_face_headless)
         _FACE_DEFAULT_LOCK();
 }
 static void face_unlock(void)
 {
     if (s_face_unlock_fn)
         s_face_unlock_fn();
-    else
+    else if (!s_face_headless)
         _FACE_DEFAULT_UNLOCK();
 }
 
@@ -83,6 +124,122 @@ static const char *TAG = "face_anim";
 #define DEFAULT_ANIM_SPEED_MS 30
 #define DEFAULT_BLINK_INTERVAL 3000
 
+#define FACE_LVGL_VERSION_AT_LEAST(major, minor) \
+    (LVGL_VERSION_MAJOR > (major) ||             \
+     (LVGL_VERSION_MAJOR == (major) && LVGL_VERSION_MINOR >= (minor)))
+
+/* Byte-swapped RGB565 images and displays arrived in LVGL 9.3 */
+#define FACE_HAS_RGB565_SWAPPED FACE_LVGL_VERSION_AT_LEAST(9, 3)
+
+/* Fixed face size from Kconfig, unless given on the command line */
+#if !defined(FACE_FIXED_SIZE) && defined(CONFIG_FACE_FIXED_SIZE) && CONFIG_FACE_FIXED_SIZE > 0
+#define FACE_FIXED_SIZE CONFIG_FACE_FIXED_SIZE
+#endif
+
+/* I1 canvases carry a two-entry ARGB8888 palette in front of the pixels */
+#define FACE_MONO_PALETTE_SIZE (2 * sizeof(lv_color32_t))
+
+typedef enum
+{
+    FACE_PART_LEFT_EYE,
+    FACE_PART_RIGHT_EYE,
+    FACE_PART_MOUTH,
+    FACE_PART_COUNT
+} face_part_t;
+
+/* Per-canvas dirty bits, one per face_part_t */
+#define FACE_DIRTY_LEFT_EYE (1u << FACE_PART_LEFT_EYE)
+#define FACE_DIRTY_RIGHT_EYE (1u << FACE_PART_RIGHT_EYE)
+#define FACE_DIRTY_MOUTH (1u << FACE_PART_MOUTH)
+#define FACE_DIRTY_EYES (FACE_DIRTY_LEFT_EYE | FACE_DIRTY_RIGHT_EYE)
+#define FACE_DIRTY_ALL (FACE_DIRTY_EYES | FACE_DIRTY_MOUTH)
+
+/* Particle effects drawn on top of a part */
+typedef enum
+{
+    FACE_FX_NONE,
+    FACE_FX_TEAR,
+    FACE_FX_SWEAT,
+    FACE_FX_SPARKLE,
+    FACE_FX_HEART,
+    FACE_FX_COUNT
+} face_fx_t;
+
+#define FACE_MAX_PARTICLES 32
+
+#define FACE_MAX_MIRRORS 4
+#define FACE_MAX_FRAME_CBS 4
+
+#define FACE_MAX_LOOKAHEAD 4
+
+/* The animation curves are tuned in ticks of the default step; elapsed
+ * time is converted back to that scale, whatever the update rate */
+#define FACE_TICK_MS DEFAULT_ANIM_SPEED_MS
+
+/* Longest interval one step catches up after a stall */
+#define FACE_MAX_STEP_MS 500
+
+/* Positions and velocities in Q8 px (per tick), canvas coordinates */
+typedef struct
+{
+    uint8_t type; /* face_fx_t, FACE_FX_NONE = free slot */
+    uint8_t part; /* face_part_t it is drawn on */
+    uint8_t size;
+    uint8_t life;
+    uint8_t max_life;
+    int32_t x;
+    int32_t y;
+    int16_t vx;
+    int16_t vy;
+    int16_t ay;
+} face_particle_t;
+
+/* Every input a part's draw function consumes, already truncated the way
+ * the renderer sees it.  Fields a part does not read stay zero. */
+typedef struct
+{
+    face_emotion_t emotion;
+    uint8_t openness;
+    int8_t mouth_curve;
+    int8_t eyebrow_angle;
+    int8_t eyebrow_height;
+    int8_t bounce;
+    int8_t bounce_sub;
+    int8_t pupil_x;
+    int8_t pupil_y;
+    int8_t pupil_sub_x;
+    int8_t pupil_sub_y;
+    uint8_t sparkle_phase;
+    uint8_t blush_intensity;
+    uint8_t diamond_mouth_phase;
+    uint16_t fx_version;
+} face_pose_t;
+
+/* The state the draw functions read, at full precision, so a frame can
+ * be rendered after the animation logic has moved on */
+typedef struct
+{
+    face_emotion_t current_emotion;
+    uint8_t left_eye_openness;
+    uint8_t right_eye_openness;
+    int8_t mouth_curve;
+    int8_t left_eyebrow_angle;
+    int8_t right_eyebrow_angle;
+    int8_t eyebrow_height;
+    uint8_t blush_intensity;
+    int8_t bounce_offset;
+    uint8_t sparkle_phase;
+    uint8_t heart_beat_phase;
+    int8_t pupil_offset_x;
+    int8_t pupil_offset_y;
+    int16_t bounce_q8;
+    int16_t pupil_x_q8;
+    int16_t pupil_y_q8;
+    uint8_t diamond_mouth_phase;
+    face_particle_t particles[FACE_MAX_PARTICLES];
+    uint16_t fx_version[FACE_PART_COUNT];
+} face_frame_t;
+
 typedef struct
 {
     lv_obj_t *left_eye_canvas;
@@ -117,198 +274,2099 @@ typedef struct
 
     int8_t pupil_offset_x;
     int8_t pupil_offset_y;
-    uint8_t tear_fall_offset;
+
+    /* Q8 positions behind bounce_offset / pupil_offset_*, which hold the
+     * truncated integer part used by the LVGL backend */
+    int16_t bounce_q8;
+    int16_t pupil_x_q8;
+    int16_t pupil_y_q8;
     uint8_t diamond_mouth_phase;
-    uint8_t sweat_drop_offset;
 
+    /* Fixed particle pool; fx_version[part] bumps whenever a particle on
+     * that part moves, spawns or dies */
+    face_particle_t particles[FACE_MAX_PARTICLES];
+    uint16_t fx_version[FACE_PART_COUNT];
+    uint32_t fx_tick;
+    uint32_t fx_seed;
+
+    /* Animation clocks in ms of elapsed time, and their values at the
+     * previous step; every step is a function of these and the state
+     * above, so a copy of face_state can be stepped ahead of time.  64 bits
+     * wide: a 32-bit ms clock wraps after 49.7 days, and no tick or curve
+     * period divides 2^32 */
+    uint64_t anim_ms;
+    uint64_t anim_prev_ms;
+    uint64_t idle_ms;
+    uint64_t idle_prev_ms;
+    int8_t diamond_direction;
+    int8_t heart_direction;
+    uint32_t step_time;
+
+#ifndef FACE_FIXED_SIZE
     uint16_t face_sz;
     uint16_t eye_cw;
     uint16_t mouth_cw;
     uint16_t mouth_ch;
+#endif
+
+    lv_obj_t *render_canvas;
+    lv_color_t *scratch_buf;
+
+    /* Extra views of the same canvases, e.g. on a second display: each is
+     * a container holding one lv_image per part */
+    lv_obj_t *mirrors[FACE_MAX_MIRRORS];
+    lv_obj_t *mirror_imgs[FACE_MAX_MIRRORS][FACE_PART_COUNT];
+
+    lv_area_t paint_area;
+    lv_area_t painted[FACE_PART_COUNT];
+    uint32_t *row_sums[FACE_PART_COUNT];
+    bool row_sums_valid[FACE_PART_COUNT];
+    face_pose_t pose[FACE_PART_COUNT];
+    bool pose_valid[FACE_PART_COUNT];
+    face_sdf_target_t sdf_target;
+
+    /* Internal-RAM band that canvases living in PSRAM are rendered
+     * through, and the canvas row it currently stands for */
+    uint8_t *tile_buf;
+    int32_t tile_y;
+
+    uint8_t *fade_src[FACE_PART_COUNT];
+    uint8_t *fade_dst[FACE_PART_COUNT];
+    bool crossfading;
+    uint8_t fade_progress;
+
+    face_emotion_t keyframe_emotion;
+    bool keyframe_closed;
+
+    /* FACE_DIRTY_* canvases whose inputs changed and await rendering */
+    uint8_t dirty;
+
+    /* Budgeted rendering: parts render into back buffers over several
+     * ticks and are copied to the displayed canvases together, all drawn
+     * from the state captured when the frame started */
+    uint8_t *back_buf[FACE_PART_COUNT];
+    face_frame_t *slice_frame;
+    bool back_stale[FACE_PART_COUNT];
+    lv_area_t present_area[FACE_PART_COUNT];
+    uint8_t present_mask;
+    uint8_t frame_pending;
+    uint32_t part_cost_us[FACE_PART_COUNT];
+
+    /* Lookahead ring: slot (ahead_head + i) % ahead_len holds the frame
+     * i + 1 steps ahead, rendered from a simulated copy of the state, the
+     * pose each of its canvases shows and the time it was stepped to */
+    uint8_t *ahead_buf[FACE_MAX_LOOKAHEAD][FACE_PART_COUNT];
+    face_pose_t ahead_pose[FACE_MAX_LOOKAHEAD][FACE_PART_COUNT];
+    uint32_t ahead_at[FACE_MAX_LOOKAHEAD];
+    uint8_t ahead_len;
+    uint8_t ahead_head;
+    uint8_t ahead_count;
+    uint32_t ahead_time;
+
+    /* Refresh-synced driver: display whose refresh steps the face, the
+     * animation time owed since the last step, and the timer that keeps
+     * that refresh from going to sleep */
+    lv_display_t *sync_disp;
+    uint32_t sync_last;
+    uint32_t sync_accum;
+    lv_timer_t *sync_timer;
+
+    /* Called once per presented step that changed any canvas */
+    face_frame_cb_t frame_cbs[FACE_MAX_FRAME_CBS];
+    void *frame_cb_user_data[FACE_MAX_FRAME_CBS];
+    bool frame_changed;
+
+    /* Direct-panel output: two strip buffers handed out alternately; a
+     * strip stays busy from its flush until face_panel_flush_ready() */
+    uint8_t *panel_strip[2];
+    volatile bool panel_busy[2];
+    uint8_t panel_next;
+    volatile uint8_t panel_done;
+    bool panel_clear;   // Next frame repaints the whole face square
+
+    /* LED-matrix output: the frame handed to matrix_flush_cb and the one
+     * being drawn, swapped whenever the new one differs */
+    uint8_t *matrix_buf[2];
 
     lv_timer_t *anim_timer;
     bool initialized;
 } face_state_t;
 
-static face_state_t face_state = {0};
+/* The live face, and the lookahead simulation, one step past the newest
+ * frame in the ring (allocated only with lookahead enabled).  Everything
+ * works on face_state, which lookahead_fill points at the simulation
+ * while stepping it. */
+static face_state_t s_face_live = {0};
+static face_state_t *s_ahead_sim;
+static face_state_t *s_face = &s_face_live;
+#define face_state (*s_face)
+
+/*
+ * Face geometry.  A FACE_FIXED_SIZE build (Kconfig "Face size") makes it a
+ * compile-time constant, so the proportions, clamps and loop bounds in the
+ * drawing code fold away; otherwise it follows the parent's size.
+ */
+#ifdef FACE_FIXED_SIZE
+#define FACE_SZ ((uint16_t)FACE_FIXED_SIZE)
+#define FACE_EYE_CW ((uint16_t)(FACE_FIXED_SIZE * 0.45f))
+#define FACE_MOUTH_CW ((uint16_t)(FACE_FIXED_SIZE * 0.45f))
+#define FACE_MOUTH_CH ((uint16_t)(FACE_FIXED_SIZE * 0.38f))
+#else
+#define FACE_SZ face_state.face_sz
+#define FACE_EYE_CW face_state.eye_cw
+#define FACE_MOUTH_CW face_state.mouth_cw
+#define FACE_MOUTH_CH face_state.mouth_ch
+#endif
 
 static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left);
 static void draw_mouth(lv_obj_t *canvas, int8_t curve);
 static void update_emotion_parameters(face_emotion_t emotion, uint8_t *left_eye, uint8_t *right_eye, int8_t *mouth,
                                       int8_t *left_brow, int8_t *right_brow, int8_t *brow_height);
+static uint32_t anim_advance(uint32_t per_tick);
 static void animation_timer_cb(lv_timer_t *timer);
+static void refr_start_cb(lv_event_t *e);
+static void sync_wake_cb(lv_timer_t *timer);
+static uint32_t sync_period(void);
+
+/* 4x4 Bayer matrix scaled to 8-bit luminance thresholds */
+static const uint8_t s_bayer4[4][4] = {
+    {8, 136, 40, 168},
+    {200, 72, 232, 104},
+    {56, 184, 24, 152},
+    {248, 120, 216, 88},
+};
+
+static lv_obj_t *part_canvas(face_part_t part)
+{
+    switch (part)
+    {
+    case FACE_PART_LEFT_EYE:
+        return face_state.left_eye_canvas;
+    case FACE_PART_RIGHT_EYE:
+        return face_state.right_eye_canvas;
+    default:
+        return face_state.mouth_canvas;
+    }
+}
 
-esp_err_t face_animation_init(face_config_t *config)
+static uint8_t *part_buf(face_part_t part)
 {
-    if (face_state.initialized)
+    switch (part)
     {
-        FACE_LOGW(TAG, "Face animation already initialized");
-        return ESP_OK;
+    case FACE_PART_LEFT_EYE:
+        return (uint8_t *)face_state.left_eye_buf;
+    case FACE_PART_RIGHT_EYE:
+        return (uint8_t *)face_state.right_eye_buf;
+    default:
+        return (uint8_t *)face_state.mouth_buf;
     }
+}
 
-    face_lock();
+static bool panel_mode(void)
+{
+    return face_state.config.panel_flush_cb != NULL;
+}
 
-    if (config != NULL)
+static bool matrix_mode(void)
+{
+    return face_state.config.matrix_flush_cb != NULL;
+}
+
+/* Animation clock: LVGL's tick, or the platform clock when LVGL may not
+ * be running at all */
+static uint32_t face_now_ms(void)
+{
+    return matrix_mode() ? (uint32_t)(face_time_us() / 1000) : lv_tick_get();
+}
+
+/* Buffer a part renders into: its back buffer under a render budget,
+ * otherwise the displayed canvas buffer itself */
+static uint8_t *part_target(face_part_t part)
+{
+    return face_state.back_buf[part] ? face_state.back_buf[part] : part_buf(part);
+}
+
+static void part_size(face_part_t part, uint16_t *w, uint16_t *h)
+{
+    if (part == FACE_PART_MOUTH)
     {
-        face_state.config = *config;
+        *w = FACE_MOUTH_CW;
+        *h = FACE_MOUTH_CH;
     }
     else
     {
-        face_state.config.parent = NULL;
-        face_state.config.animation_speed = DEFAULT_ANIM_SPEED_MS;
-        face_state.config.blink_interval = DEFAULT_BLINK_INTERVAL;
-        face_state.config.auto_blink = true;
+        *w = FACE_EYE_CW;
+        *h = FACE_EYE_CW;
     }
+}
 
-    lv_obj_t *parent_obj = (face_state.config.parent != NULL)
-                               ? face_state.config.parent
-                               : lv_scr_act();
-    lv_obj_update_layout(parent_obj);
-    int32_t parent_w = lv_obj_get_width(parent_obj);
-    int32_t parent_h = lv_obj_get_height(parent_obj);
-    uint16_t face_sz = (uint16_t)((parent_w < parent_h) ? parent_w : parent_h);
-
+/* Derive every canvas dimension from the face's square size */
+static void set_face_size(uint16_t face_sz)
+{
+#ifdef FACE_FIXED_SIZE
+    if (face_sz != FACE_FIXED_SIZE)
+        FACE_LOGW(TAG, "Built for a %u px face (FACE_FIXED_SIZE), not %u px", FACE_FIXED_SIZE, face_sz);
+#else
     face_state.face_sz = face_sz;
     face_state.eye_cw = (uint16_t)(face_sz * 0.45f);
     face_state.mouth_cw = (uint16_t)(face_sz * 0.45f);
     face_state.mouth_ch = (uint16_t)(face_sz * 0.38f);
+#endif
+}
 
-    FACE_LOGI(TAG, "Parent: %dx%d, face_sz: %u, eye: %upx, mouth: %ux%upx",
-              parent_w, parent_h, face_sz,
-              face_state.eye_cw, face_state.mouth_cw, face_state.mouth_ch);
+/* Top-left corner of a part inside the face_sz x face_sz face */
+static void part_origin(face_part_t part, int16_t *x, int16_t *y)
+{
+    uint16_t face_sz = FACE_SZ;
+    int16_t eye_gap = FACE_EYE_CW / 4;
 
-    face_state.face_container = lv_obj_create(parent_obj);
-    lv_obj_set_size(face_state.face_container, face_sz, face_sz);
-    lv_obj_center(face_state.face_container);
-    lv_obj_set_style_bg_opa(face_state.face_container, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_width(face_state.face_container, 0, 0);
-    lv_obj_set_style_pad_all(face_state.face_container, 0, 0);
+    switch (part)
+    {
+    case FACE_PART_LEFT_EYE:
+        *x = (int16_t)(face_sz / 2) - FACE_EYE_CW - eye_gap / 2;
+        *y = (int16_t)(face_sz * 0.12f);
+        break;
+    case FACE_PART_RIGHT_EYE:
+        *x = (int16_t)(face_sz / 2) + eye_gap / 2;
+        *y = (int16_t)(face_sz * 0.12f);
+        break;
+    default:
+        *x = (int16_t)(face_sz / 2) - (int16_t)(FACE_MOUTH_CW / 2);
+        *y = (int16_t)(face_sz * 0.62f);
+        break;
+    }
+}
 
-    lv_obj_clear_flag(face_state.face_container, LV_OBJ_FLAG_SCROLLABLE);
+static bool render_is_transparent(void)
+{
+    return face_state.config.render_mode == FACE_RENDER_ARGB8888 ||
+           face_state.config.render_mode == FACE_RENDER_RGB565A8;
+}
 
-    size_t eye_buf_size = face_state.eye_cw * face_state.eye_cw;
-    size_t mouth_buf_size = face_state.mouth_cw * face_state.mouth_ch;
+static lv_color_format_t canvas_format(void)
+{
+    switch (face_state.config.render_mode)
+    {
+    case FACE_RENDER_MONO:
+        return LV_COLOR_FORMAT_I1;
+    case FACE_RENDER_ARGB8888:
+        return LV_COLOR_FORMAT_ARGB8888;
+    case FACE_RENDER_RGB565A8:
+        return LV_COLOR_FORMAT_RGB565A8;
+    case FACE_RENDER_RGB888:
+        return LV_COLOR_FORMAT_RGB888;
+    case FACE_RENDER_XRGB8888:
+        return LV_COLOR_FORMAT_XRGB8888;
+#if FACE_HAS_RGB565_SWAPPED
+    case FACE_RENDER_RGB565_SWAPPED:
+        return LV_COLOR_FORMAT_RGB565_SWAPPED;
+#endif
+    default:
+        return LV_COLOR_FORMAT_RGB565;
+    }
+}
+
+/* Format the draw layer renders into; differs from canvas_format() when the
+ * result is packed afterwards (mono, RGB565A8, RGB565_SWAPPED). */
+static lv_color_format_t work_format(void)
+{
+    switch (face_state.config.render_mode)
+    {
+    case FACE_RENDER_ARGB8888:
+    case FACE_RENDER_RGB565A8:
+        return LV_COLOR_FORMAT_ARGB8888;
+    case FACE_RENDER_RGB888:
+        return LV_COLOR_FORMAT_RGB888;
+    case FACE_RENDER_XRGB8888:
+        return LV_COLOR_FORMAT_XRGB8888;
+    default:
+        return LV_COLOR_FORMAT_RGB565;
+    }
+}
 
-    face_state.left_eye_buf = FACE_MALLOC_CANVAS(eye_buf_size * sizeof(lv_color_t));
-    face_state.right_eye_buf = FACE_MALLOC_CANVAS(eye_buf_size * sizeof(lv_color_t));
-    face_state.mouth_buf = FACE_MALLOC_CANVAS(mouth_buf_size * sizeof(lv_color_t));
+/* Render into a work-format scratch and pack the result into the canvas */
+static bool render_is_packed(void)
+{
+    return face_state.config.render_mode == FACE_RENDER_MONO ||
+           face_state.config.render_mode == FACE_RENDER_RGB565A8 ||
+           face_state.config.render_mode == FACE_RENDER_RGB565_SWAPPED;
+}
 
-    if (!face_state.left_eye_buf || !face_state.right_eye_buf || !face_state.mouth_buf)
+/* Bytes per pixel of the canvas's colour plane (not for mono) */
+static uint32_t canvas_px_size(void)
+{
+    switch (face_state.config.render_mode)
     {
-        FACE_LOGE(TAG, "Failed to allocate canvas buffers");
-        face_unlock();
-        return ESP_ERR_NO_MEM;
+    case FACE_RENDER_ARGB8888:
+    case FACE_RENDER_XRGB8888:
+        return 4;
+    case FACE_RENDER_RGB888:
+        return 3;
+    default:
+        return 2;
     }
+}
 
-    int16_t eye_gap = face_state.eye_cw / 4;
-    int16_t eye_y = (int16_t)(face_sz * 0.12f);
-    int16_t left_eye_x = (int16_t)(face_sz / 2) - face_state.eye_cw - eye_gap / 2;
-    int16_t right_eye_x = (int16_t)(face_sz / 2) + eye_gap / 2;
-    int16_t mouth_y = (int16_t)(face_sz * 0.62f);
-    int16_t mouth_x = (int16_t)(face_sz / 2) - (int16_t)(face_state.mouth_cw / 2);
+/*
+ * Resolve FACE_RENDER_NATIVE to the mode whose canvases the display takes
+ * as they are, so LVGL blends them without converting every pixel at
+ * flush time.  Formats without a matching mode keep RGB565.
+ */
+static face_render_mode_t native_render_mode(lv_obj_t *parent)
+{
+    lv_display_t *disp = lv_obj_get_display(parent);
+    lv_color_format_t cf = disp ? lv_display_get_color_format(disp) : LV_COLOR_FORMAT_RGB565;
 
-    face_state.left_eye_canvas = lv_canvas_create(face_state.face_container);
-    lv_canvas_set_buffer(face_state.left_eye_canvas, face_state.left_eye_buf,
-                         face_state.eye_cw, face_state.eye_cw,
-                         LV_COLOR_FORMAT_RGB565);
-    lv_obj_set_pos(face_state.left_eye_canvas, left_eye_x, eye_y);
+    switch (cf)
+    {
+    case LV_COLOR_FORMAT_RGB888:
+        return FACE_RENDER_RGB888;
+    case LV_COLOR_FORMAT_XRGB8888:
+    case LV_COLOR_FORMAT_ARGB8888:
+        return FACE_RENDER_XRGB8888;
+    case LV_COLOR_FORMAT_I1:
+        return FACE_RENDER_MONO;
+#if FACE_HAS_RGB565_SWAPPED
+    case LV_COLOR_FORMAT_RGB565_SWAPPED:
+        return FACE_RENDER_RGB565_SWAPPED;
+#endif
+    case LV_COLOR_FORMAT_RGB565:
+        return FACE_RENDER_RGB565;
+    default:
+        FACE_LOGW(TAG, "No native render mode for display format %d, using RGB565", cf);
+        return FACE_RENDER_RGB565;
+    }
+}
 
-    face_state.right_eye_canvas = lv_canvas_create(face_state.face_container);
-    lv_canvas_set_buffer(face_state.right_eye_canvas, face_state.right_eye_buf,
-                         face_state.eye_cw, face_state.eye_cw,
-                         LV_COLOR_FORMAT_RGB565);
-    lv_obj_set_pos(face_state.right_eye_canvas, right_eye_x, eye_y);
+static size_t part_buf_size(face_part_t part)
+{
+    uint16_t w, h;
+    part_size(part, &w, &h);
 
-    face_state.mouth_canvas = lv_canvas_create(face_state.face_container);
-    lv_canvas_set_buffer(face_state.mouth_canvas, face_state.mouth_buf,
-                         face_state.mouth_cw, face_state.mouth_ch,
-                         LV_COLOR_FORMAT_RGB565);
-    lv_obj_set_pos(face_state.mouth_canvas, mouth_x, mouth_y);
+    switch (face_state.config.render_mode)
+    {
+    case FACE_RENDER_MONO:
+        return FACE_MONO_PALETTE_SIZE + (size_t)lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_I1) * h;
+    case FACE_RENDER_ARGB8888:
+        return (size_t)lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888) * h;
+    case FACE_RENDER_RGB565A8:
+    {
+        /* RGB565 plane followed by an A8 plane at half the stride */
+        size_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+        return stride * h + (stride / 2) * h;
+    }
+    default:
+        return (size_t)lv_draw_buf_width_to_stride(w, canvas_format()) * h;
+    }
+}
 
-    face_state.current_emotion = FACE_NEUTRAL;
-    face_state.target_emotion = FACE_NEUTRAL;
-    face_state.left_eye_openness = 100;
-    face_state.right_eye_openness = 100;
-    face_state.mouth_curve = 0;
-    face_state.left_eyebrow_angle = 0;
-    face_state.right_eyebrow_angle = 0;
-    face_state.eyebrow_height = 0;
-    face_state.transition_progress = 100;
-    face_state.last_blink_time = lv_tick_get();
+static void area_set_empty(lv_area_t *a)
+{
+    a->x1 = INT16_MAX;
+    a->y1 = INT16_MAX;
+    a->x2 = INT16_MIN;
+    a->y2 = INT16_MIN;
+}
 
-    face_state.blush_intensity = 0;
-    face_state.bounce_offset = 0;
-    face_state.sparkle_phase = 0;
-    face_state.heart_beat_phase = 0;
+static void area_join(lv_area_t *dst, const lv_area_t *src)
+{
+    if (src->x1 < dst->x1)
+        dst->x1 = src->x1;
+    if (src->y1 < dst->y1)
+        dst->y1 = src->y1;
+    if (src->x2 > dst->x2)
+        dst->x2 = src->x2;
+    if (src->y2 > dst->y2)
+        dst->y2 = src->y2;
+}
+
+/* Clip to a w x h canvas; returns false if nothing is left */
+static bool area_clip(lv_area_t *a, int32_t w, int32_t h)
+{
+    if (a->x1 < 0)
+        a->x1 = 0;
+    if (a->y1 < 0)
+        a->y1 = 0;
+    if (a->x2 > w - 1)
+        a->x2 = w - 1;
+    if (a->y2 > h - 1)
+        a->y2 = h - 1;
+    return a->x1 <= a->x2 && a->y1 <= a->y2;
+}
+
+/* Grow an area to multiples of `n` px on both axes; AMOLED controllers
+ * such as the SH8601 or CO5300 reject odd window coordinates. */
+static void area_align(lv_area_t *a, uint8_t n)
+{
+    if (n < 2)
+        return;
 
-    draw_eye(face_state.left_eye_canvas, face_state.left_eye_openness, true);
-    draw_eye(face_state.right_eye_canvas, face_state.right_eye_openness, false);
-    draw_mouth(face_state.mouth_canvas, face_state.mouth_curve);
+    a->x1 -= ((a->x1 % n) + n) % n;
+    a->y1 -= ((a->y1 % n) + n) % n;
+    a->x2 += n - 1 - ((a->x2 % n) + n) % n;
+    a->y2 += n - 1 - ((a->y2 % n) + n) % n;
+}
 
-    face_state.anim_timer = lv_timer_create(animation_timer_cb,
-                                            face_state.config.animation_speed,
-                                            NULL);
+/* Fraction of a Q8 position left after truncation, in SDF 1/16 px units */
+static int32_t q8_frac16(int16_t q8)
+{
+    return (q8 - (q8 / 256) * 256) / 16;
+}
 
-    face_unlock();
+/* Draw wrappers: record the painted bounding box so transparent modes can
+ * clear and invalidate only what was actually drawn. */
+static bool backend_is_sdf(void)
+{
+    return face_state.config.backend == FACE_BACKEND_SDF ||
+           face_state.config.backend == FACE_BACKEND_MESH;
+}
 
-    face_state.initialized = true;
-    FACE_LOGI(TAG, "Face animation initialized successfully");
+/* Mesh features also draw straight into sdf_target */
+static bool backend_is_mesh(void)
+{
+    return face_state.config.backend == FACE_BACKEND_MESH;
+}
 
-    return ESP_OK;
+static void face_draw_rect(lv_layer_t *layer, const lv_draw_rect_dsc_t *dsc, const lv_area_t *area)
+{
+    area_join(&face_state.paint_area, area);
+    if (backend_is_sdf())
+    {
+        face_sdf_rect(&face_state.sdf_target, dsc, area);
+    }
+    else
+    {
+        lv_area_t a = *area;
+        a.y1 -= face_state.tile_y;
+        a.y2 -= face_state.tile_y;
+        lv_draw_rect(layer, dsc, &a);
+    }
 }
 
-static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
+static void face_draw_line(lv_layer_t *layer, const lv_draw_line_dsc_t *dsc)
 {
-    if (!canvas)
-        return;
+    int32_t pad = dsc->width / 2 + 1;
+    lv_area_t area = {
+        LV_MIN(dsc->p1.x, dsc->p2.x) - pad,
+        LV_MIN(dsc->p1.y, dsc->p2.y) - pad,
+        LV_MAX(dsc->p1.x, dsc->p2.x) + pad,
+        LV_MAX(dsc->p1.y, dsc->p2.y) + pad,
+    };
+    area_join(&face_state.paint_area, &area);
+    if (backend_is_sdf())
+    {
+        face_sdf_line(&face_state.sdf_target, dsc);
+    }
+    else
+    {
+        lv_draw_line_dsc_t d = *dsc;
+        d.p1.y -= face_state.tile_y;
+        d.p2.y -= face_state.tile_y;
+        lv_draw_line(layer, &d);
+    }
+}
 
-    uint16_t width = face_state.eye_cw;
-    uint16_t height = face_state.eye_cw;
+/* Single-primitive shapes, only used by the SDF backend; the LVGL backend
+ * builds the same features from overlapping rounded rects. */
+static void face_draw_heart(int32_t cx, int32_t tip_y, int32_t size, lv_color_t color, lv_opa_t opa)
+{
+    lv_area_t area = {cx - size * 62 / 100, tip_y - size * 111 / 100, cx + size * 62 / 100, tip_y};
+    area_join(&face_state.paint_area, &area);
+    face_sdf_heart(&face_state.sdf_target, cx, tip_y, size, color, opa);
+}
+
+static void face_draw_diamond(int32_t cx, int32_t cy, int32_t half, const lv_draw_rect_dsc_t *dsc)
+{
+    lv_area_t area = {cx - half - 1, cy - half - 1, cx + half + 1, cy + half + 1};
+    area_join(&face_state.paint_area, &area);
+    face_sdf_diamond(&face_state.sdf_target, cx, cy, half, dsc);
+}
 
-    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+/*
+ * Evaluate a blend-shape mesh around (cx, cy) with half extents hw x hh
+ * (1/16 px), fill it and stroke its edges.  `bounds` receives the
+ * outline's pixel box.
+ */
+static void face_draw_mesh(const face_mesh_t *mesh, const uint16_t *weights,
+                           int32_t cx, int32_t cy, int32_t hw, int32_t hh,
+                           lv_color_t fill, lv_opa_t fill_opa, int32_t border_w, lv_area_t *bounds)
+{
+    int32_t xs[FACE_MESH_MAX_VERTS], ys[FACE_MESH_MAX_VERTS];
+    face_mesh_eval(mesh, weights, cx, cy, hw, hh, xs, ys);
 
-    lv_layer_t layer;
-    lv_canvas_init_layer(canvas, &layer);
+    area_set_empty(bounds);
+    for (uint32_t i = 0; i < mesh->verts; i++)
+    {
+        lv_area_t v = {xs[i] >> 4, ys[i] >> 4, xs[i] >> 4, ys[i] >> 4};
+        area_join(bounds, &v);
+    }
 
-    int16_t eye_width = width * 0.75;
-    int16_t eye_height = (eye_width * openness) / 100;
-    if (eye_height < 8)
-        eye_height = 8;
-    int16_t center_x = width / 2;
-    int16_t center_y = (height * 0.6) + face_state.bounce_offset;
+    lv_area_t area = {bounds->x1 - border_w, bounds->y1 - border_w,
+                      bounds->x2 + border_w, bounds->y2 + border_w};
+    area_join(&face_state.paint_area, &area);
+    face_sdf_polygon(&face_state.sdf_target, xs, ys, mesh->verts, fill, fill_opa);
 
     lv_draw_line_dsc_t line_dsc;
     lv_draw_line_dsc_init(&line_dsc);
-    line_dsc.color = lv_color_make(80, 60, 40);
-    line_dsc.width = 4;
+    line_dsc.color = lv_color_black();
+    line_dsc.width = border_w;
     line_dsc.opa = LV_OPA_COVER;
-
-    int8_t eyebrow_angle = is_left ? face_state.left_eyebrow_angle : face_state.right_eyebrow_angle;
-    int16_t eyebrow_y = center_y - eye_width / 2 - 6 + face_state.eyebrow_height;
-    int16_t eyebrow_width = eye_width * 0.9;
-
-    float angle_rad = eyebrow_angle * 3.14159 / 180.0;
-    int16_t y_offset = eyebrow_width * 0.25 * sin(angle_rad);
-
     line_dsc.round_start = 1;
     line_dsc.round_end = 1;
-
-    if (is_left)
+    for (uint32_t i = 0, j = mesh->verts - 1; i < mesh->verts; j = i++)
     {
-        line_dsc.p1.x = center_x - eyebrow_width * 0.5;
-        line_dsc.p1.y = eyebrow_y - y_offset;
-        line_dsc.p2.x = center_x + eyebrow_width * 0.5;
-        line_dsc.p2.y = eyebrow_y + y_offset;
+        line_dsc.p1.x = xs[j] >> 4;
+        line_dsc.p1.y = ys[j] >> 4;
+        line_dsc.p2.x = xs[i] >> 4;
+        line_dsc.p2.y = ys[i] >> 4;
+        face_sdf_line(&face_state.sdf_target, &line_dsc);
     }
-    else
+}
+
+/* Small heart for particles; the LVGL backend has no heart primitive, so
+ * it is approximated by two bumps over a tapering body. */
+static void fx_draw_heart(lv_layer_t *layer, lv_draw_rect_dsc_t *dsc, int32_t cx, int32_t cy, int32_t size)
+{
+    if (backend_is_sdf())
     {
-        line_dsc.p1.x = center_x - eyebrow_width * 0.5;
-        line_dsc.p1.y = eyebrow_y + y_offset;
+        face_draw_heart(cx, cy + size / 2, size, dsc->bg_color, dsc->bg_opa);
+        return;
+    }
+
+    int32_t r = size / 4 + 1;
+    dsc->radius = LV_RADIUS_CIRCLE;
+    lv_area_t bump = {cx - size / 4 - r, cy - size / 4 - r, cx - size / 4 + r, cy - size / 4 + r};
+    face_draw_rect(layer, dsc, &bump);
+    bump.x1 += size / 2;
+    bump.x2 += size / 2;
+    face_draw_rect(layer, dsc, &bump);
+
+    dsc->radius = r;
+    lv_area_t body = {cx - size / 2 + 1, cy - size / 4, cx + size / 2 - 1, cy + size / 8};
+    face_draw_rect(layer, dsc, &body);
+
+    dsc->radius = 2;
+    lv_area_t tip = {cx - size / 5, cy, cx + size / 5, cy + size / 2};
+    face_draw_rect(layer, dsc, &tip);
+}
+
+/* Fade the last few ticks of a particle's life */
+static lv_opa_t fx_opa(const face_particle_t *pt, lv_opa_t opa)
+{
+    return pt->life >= 8 ? opa : (lv_opa_t)((opa * pt->life) / 8);
+}
+
+/*
+ * Draw the pool's particles for one part, batched by effect type so each
+ * descriptor is set up once per frame rather than once per particle.
+ */
+static void draw_particles(lv_layer_t *layer, face_part_t part)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_line_dsc_t line_dsc;
+
+    for (int type = FACE_FX_TEAR; type < FACE_FX_COUNT; type++)
+    {
+        lv_draw_rect_dsc_init(&dsc);
+        lv_draw_line_dsc_init(&line_dsc);
+        dsc.border_width = 0;
+
+        switch (type)
+        {
+        case FACE_FX_TEAR:
+            dsc.bg_color = lv_color_make(150, 200, 255);
+            dsc.radius = 5;
+            line_dsc.color = dsc.bg_color;
+            line_dsc.width = 2;
+            line_dsc.round_start = 1;
+            line_dsc.round_end = 1;
+            break;
+        case FACE_FX_SWEAT:
+            dsc.bg_color = lv_color_make(120, 200, 255);
+            dsc.border_color = lv_color_make(80, 150, 240);
+            dsc.border_width = 1;
+            dsc.border_opa = LV_OPA_60;
+            dsc.radius = 6;
+            break;
+        case FACE_FX_SPARKLE:
+            dsc.bg_color = lv_color_make(255, 240, 100);
+            dsc.radius = 1;
+            break;
+        default:
+            dsc.bg_color = lv_color_make(255, 60, 120);
+            break;
+        }
+
+        for (int i = 0; i < FACE_MAX_PARTICLES; i++)
+        {
+            const face_particle_t *pt = &face_state.particles[i];
+            if (pt->type != type || pt->part != part)
+                continue;
+
+            int32_t x = pt->x >> 8;
+            int32_t y = pt->y >> 8;
+            int32_t sz = pt->size;
+
+            switch (type)
+            {
+            case FACE_FX_TEAR:
+            {
+                /* Streak behind the drop grows with its speed */
+                line_dsc.opa = fx_opa(pt, LV_OPA_40);
+                line_dsc.p1.x = x;
+                line_dsc.p1.y = y - sz - (pt->vy >> 7);
+                line_dsc.p2.x = x;
+                line_dsc.p2.y = y - sz;
+                face_draw_line(layer, &line_dsc);
+
+                dsc.bg_opa = fx_opa(pt, LV_OPA_80);
+                lv_area_t a = {x - sz / 2, y - sz, x + sz / 2, y + sz / 2};
+                face_draw_rect(layer, &dsc, &a);
+                break;
+            }
+            case FACE_FX_SWEAT:
+            {
+                bool big = sz >= 4;
+                lv_draw_rect_dsc_t shine;
+                lv_draw_rect_dsc_init(&shine);
+
+                dsc.bg_opa = fx_opa(pt, big ? LV_OPA_90 : LV_OPA_70);
+                lv_area_t a = {x - sz, y - (big ? 10 : 7), x + sz, y + sz};
+                face_draw_rect(layer, &dsc, &a);
+
+                shine.bg_color = lv_color_white();
+                shine.bg_opa = fx_opa(pt, LV_OPA_80);
+                shine.border_width = 0;
+                shine.radius = 3;
+                lv_area_t s = {x - (big ? 2 : 1), a.y1 + 2, x, a.y1 + (big ? 5 : 4)};
+                face_draw_rect(layer, &shine, &s);
+                break;
+            }
+            case FACE_FX_SPARKLE:
+            {
+                int32_t h = sz * pt->life / pt->max_life + 1;
+                dsc.bg_opa = fx_opa(pt, LV_OPA_COVER);
+                lv_area_t a = {x - h, y - h, x + h, y + h};
+                face_draw_rect(layer, &dsc, &a);
+                break;
+            }
+            default:
+                dsc.bg_opa = fx_opa(pt, LV_OPA_90);
+                fx_draw_heart(layer, &dsc, x, y, sz);
+                break;
+            }
+        }
+    }
+}
+
+static void canvas_clear(lv_obj_t *canvas)
+{
+    /* Transparent canvases are reset by render_part() over the last
+     * painted box only, instead of a full-canvas fill. */
+    if (render_is_transparent())
+        return;
+
+    if (canvas)
+        lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    else
+        face_sdf_fill(&face_state.sdf_target, lv_color_white(), LV_OPA_COVER);
+}
+
+static void argb8888_clear(uint8_t *buf, uint16_t w, const lv_area_t *a)
+{
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888);
+    size_t len = (size_t)(a->x2 - a->x1 + 1) * 4;
+
+    for (int32_t y = a->y1; y <= a->y2; y++)
+        memset(buf + y * stride + a->x1 * 4, 0, len);
+}
+
+/* Convert the ARGB8888 scratch into the part's RGB565A8 buffer over `a` */
+static void rgb565a8_pack(face_part_t part, const lv_area_t *a)
+{
+    uint16_t w, h;
+    part_size(part, &w, &h);
+
+    uint32_t src_stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888);
+    uint32_t dst_stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    const uint8_t *src = (const uint8_t *)face_state.scratch_buf;
+    uint8_t *dst = part_target(part);
+    uint8_t *alpha = dst + dst_stride * h;
+
+    for (int32_t y = a->y1; y <= a->y2; y++)
+    {
+        const uint8_t *s = src + y * src_stride + a->x1 * 4;
+        uint16_t *d = (uint16_t *)(dst + y * dst_stride) + a->x1;
+        uint8_t *da = alpha + y * (dst_stride / 2) + a->x1;
+
+        for (int32_t x = a->x1; x <= a->x2; x++, s += 4)
+        {
+            *d++ = (uint16_t)(((s[2] & 0xF8) << 8) | ((s[1] & 0xFC) << 3) | (s[0] >> 3));
+            *da++ = s[3];
+        }
+    }
+}
+
+/* Copy the RGB565 scratch into the part's byte-swapped canvas over `a`;
+ * the swap happens once per redraw instead of once per flush */
+static void rgb565_swap_pack(face_part_t part, const lv_area_t *a)
+{
+    uint16_t w, h;
+    part_size(part, &w, &h);
+
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    const uint8_t *src = (const uint8_t *)face_state.scratch_buf;
+    uint8_t *dst = part_target(part);
+
+    for (int32_t y = a->y1; y <= a->y2; y++)
+    {
+        const uint16_t *s = (const uint16_t *)(src + y * stride) + a->x1;
+        uint16_t *d = (uint16_t *)(dst + y * stride) + a->x1;
+
+        for (int32_t x = a->x1; x <= a->x2; x++, s++)
+            *d++ = (uint16_t)((*s << 8) | (*s >> 8));
+    }
+}
+
+/*
+ * Threshold the RGB565 scratch render into the part's I1 buffer with 4x4
+ * ordered dithering, so translucent blush and tears come out as patterns
+ * instead of vanishing.  Returns false when no pixel changed; otherwise
+ * `changed` receives the byte-aligned dirty box in canvas coordinates.
+ */
+static bool mono_pack(face_part_t part, lv_area_t *changed)
+{
+    uint16_t w, h;
+    part_size(part, &w, &h);
+
+    uint32_t src_stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565) / 2;
+    uint32_t dst_stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_I1);
+    const uint16_t *src = (const uint16_t *)face_state.scratch_buf;
+    uint8_t *dst = part_target(part) + FACE_MONO_PALETTE_SIZE;
+
+    changed->x1 = w;
+    changed->y1 = h;
+    changed->x2 = -1;
+    changed->y2 = -1;
+
+    for (int32_t y = 0; y < h; y++)
+    {
+        const uint8_t *thresh = s_bayer4[y & 3];
+        const uint16_t *src_row = src + y * src_stride;
+        uint8_t *dst_row = dst + y * dst_stride;
+
+        for (int32_t x0 = 0; x0 < w; x0 += 8)
+        {
+            int32_t n = (w - x0 < 8) ? (w - x0) : 8;
+            uint8_t bits = 0;
+
+            for (int32_t i = 0; i < n; i++)
+            {
+                uint16_t px = src_row[x0 + i];
+                uint32_t luma = (((px >> 11) & 0x1F) * 157 +
+                                 ((px >> 5) & 0x3F) * 152 +
+                                 (px & 0x1F) * 60) >> 6;
+                if (luma < thresh[(x0 + i) & 3])
+                    bits |= 0x80 >> i;
+            }
+
+            if (dst_row[x0 / 8] != bits)
+            {
+                dst_row[x0 / 8] = bits;
+                if (x0 < changed->x1)
+                    changed->x1 = x0;
+                if (x0 + n - 1 > changed->x2)
+                    changed->x2 = x0 + n - 1;
+                if (y < changed->y1)
+                    changed->y1 = y;
+                changed->y2 = y;
+            }
+        }
+    }
+
+    return changed->x2 >= 0;
+}
+
+/* Rotate-and-add over one row; a changed or moved pixel changes the sum */
+static uint32_t row_checksum(const uint8_t *row, uint32_t len, uint32_t sum)
+{
+    if (((uintptr_t)row & 3) == 0)
+    {
+        const uint32_t *word = (const uint32_t *)row;
+        for (; len >= 4; len -= 4, row += 4)
+            sum = ((sum << 5) | (sum >> 27)) + *word++;
+    }
+    for (; len > 0; len--)
+        sum = ((sum << 5) | (sum >> 27)) + *row++;
+
+    return sum;
+}
+
+/*
+ * Compare the displayed rows inside `changed` against last frame's
+ * checksums and narrow it to the span that actually moved.  Returns false
+ * when every row is identical, so the canvas need not be flushed at all.
+ * Without a valid previous frame every row is rehashed and the whole
+ * canvas counts as changed.
+ */
+static bool rows_changed(face_part_t part, lv_area_t *changed)
+{
+    uint32_t *sums = face_state.row_sums[part];
+    if (!sums)
+        return true;
+
+    uint16_t w, h;
+    part_size(part, &w, &h);
+
+    uint32_t stride = lv_draw_buf_width_to_stride(w, canvas_format());
+    uint32_t row_bytes = (uint32_t)w * canvas_px_size();
+    const uint8_t *buf = part_target(part);
+    const uint8_t *alpha = buf + stride * h;
+    bool valid = face_state.row_sums_valid[part];
+    int32_t y1 = valid ? changed->y1 : 0;
+    int32_t y2 = valid ? changed->y2 : h - 1;
+    int32_t first = -1;
+    int32_t last = -1;
+
+    for (int32_t y = y1; y <= y2; y++)
+    {
+        uint32_t sum = row_checksum(buf + y * stride, row_bytes, 0);
+        if (face_state.config.render_mode == FACE_RENDER_RGB565A8)
+            sum = row_checksum(alpha + y * (stride / 2), w, sum);
+
+        if (!valid || sum != sums[y])
+        {
+            sums[y] = sum;
+            if (first < 0)
+                first = y;
+            last = y;
+        }
+    }
+
+    face_state.row_sums_valid[part] = true;
+
+    if (!valid)
+    {
+        *changed = (lv_area_t){0, 0, w - 1, h - 1};
+        return true;
+    }
+    if (first < 0)
+        return false;
+
+    changed->y1 = first;
+    changed->y2 = last;
+    return true;
+}
+
+static void pose_capture(face_part_t part, face_pose_t *pose)
+{
+    bool sdf = backend_is_sdf();
+
+    memset(pose, 0, sizeof(*pose));
+    pose->emotion = face_state.current_emotion;
+    pose->bounce = face_state.bounce_offset;
+    pose->bounce_sub = sdf ? (int8_t)q8_frac16(face_state.bounce_q8) : 0;
+    pose->fx_version = face_state.fx_version[part];
+
+    if (part == FACE_PART_MOUTH)
+    {
+        pose->mouth_curve = face_state.mouth_curve;
+        pose->diamond_mouth_phase = face_state.diamond_mouth_phase;
+        return;
+    }
+
+    bool is_left = (part == FACE_PART_LEFT_EYE);
+    pose->openness = is_left ? face_state.left_eye_openness : face_state.right_eye_openness;
+    pose->eyebrow_angle = is_left ? face_state.left_eyebrow_angle : face_state.right_eyebrow_angle;
+    pose->eyebrow_height = face_state.eyebrow_height;
+    pose->pupil_x = face_state.pupil_offset_x;
+    pose->pupil_y = face_state.pupil_offset_y;
+    pose->pupil_sub_x = sdf ? (int8_t)q8_frac16(face_state.pupil_x_q8) : 0;
+    pose->pupil_sub_y = sdf ? (int8_t)q8_frac16(face_state.pupil_y_q8) : 0;
+    pose->sparkle_phase = face_state.sparkle_phase;
+    pose->blush_intensity = face_state.blush_intensity;
+}
+
+static void flush_area(face_part_t part, const lv_area_t *area)
+{
+#if FACE_LVGL_VERSION_AT_LEAST(9, 1)
+    lv_image_cache_drop(lv_canvas_get_image(part_canvas(part)));
+#endif
+    /* Invalidate through the container: an aligned area may reach past the
+     * canvas and would otherwise be clipped back to odd coordinates. */
+    lv_obj_invalidate_area(face_state.face_container, area);
+
+    /* Same area relative to each mirror, on whichever display it lives */
+    lv_area_t origin;
+    lv_obj_get_coords(face_state.face_container, &origin);
+    for (int m = 0; m < FACE_MAX_MIRRORS; m++)
+    {
+        if (!face_state.mirrors[m])
+            continue;
+
+        lv_area_t mirror;
+        lv_obj_get_coords(face_state.mirrors[m], &mirror);
+        lv_area_t a = {
+            area->x1 - origin.x1 + mirror.x1,
+            area->y1 - origin.y1 + mirror.y1,
+            area->x2 - origin.x1 + mirror.x1,
+            area->y2 - origin.y1 + mirror.y1,
+        };
+        area_align(&a, face_state.config.invalidate_align);
+        lv_obj_invalidate_area(face_state.mirrors[m], &a);
+    }
+
+    if (face_state.config.region_cb)
+        face_state.config.region_cb(area, face_state.config.region_cb_user_data);
+    face_state.frame_changed = true;
+}
+
+/* Invalidate the rows of `changed` (canvas coordinates) whose checksum
+ * moved, or queue them for the next commit under a render budget */
+static void flush_changed(face_part_t part, lv_area_t *changed)
+{
+    if (face_state.config.render_mode != FACE_RENDER_MONO && !rows_changed(part, changed))
+        return;
+
+    lv_area_t coords;
+    lv_obj_get_coords(part_canvas(part), &coords);
+    lv_area_t area = {
+        coords.x1 + changed->x1,
+        coords.y1 + changed->y1,
+        coords.x1 + changed->x2,
+        coords.y1 + changed->y2,
+    };
+    area_align(&area, face_state.config.invalidate_align);
+
+    if (!face_state.back_buf[part])
+    {
+        flush_area(part, &area);
+    }
+    else if (face_state.present_mask & (1u << part))
+    {
+        area_join(&face_state.present_area[part], &area);
+    }
+    else
+    {
+        face_state.present_area[part] = area;
+        face_state.present_mask |= 1u << part;
+    }
+}
+
+/* Publish every part rendered since the last commit in one go */
+static void commit_frame(void)
+{
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        if (!(face_state.present_mask & (1u << p)))
+            continue;
+
+        memcpy(part_buf((face_part_t)p), face_state.back_buf[p], part_buf_size((face_part_t)p));
+        flush_area((face_part_t)p, &face_state.present_area[p]);
+    }
+    face_state.present_mask = 0;
+}
+
+static void draw_part(face_part_t part, lv_obj_t *target)
+{
+    if (part == FACE_PART_MOUTH)
+        draw_mouth(target, face_state.mouth_curve);
+    else if (part == FACE_PART_LEFT_EYE)
+        draw_eye(target, face_state.left_eye_openness, true);
+    else
+        draw_eye(target, face_state.right_eye_openness, false);
+}
+
+/*
+ * Draw a part whose buffer is in PSRAM band by band through the internal
+ * tile: fills and blends run in SRAM and each finished band goes out in
+ * one sequential copy.  Every band replays the whole part; primitives
+ * outside it are clipped before any pixel work.
+ */
+static void draw_part_tiled(face_part_t part, lv_obj_t *target, uint8_t *work_buf,
+                            uint16_t w, uint16_t h)
+{
+    uint32_t stride = lv_draw_buf_width_to_stride(w, work_format());
+    /* Transparent modes draw over what the buffer already holds */
+    bool load = render_is_transparent();
+
+    for (int32_t y0 = 0; y0 < h; y0 += FACE_TILE_ROWS)
+    {
+        int32_t rows = LV_MIN(FACE_TILE_ROWS, h - y0);
+        uint8_t *band = work_buf + y0 * stride;
+        if (load)
+            memcpy(face_state.tile_buf, band, stride * rows);
+
+        lv_canvas_set_buffer(target, face_state.tile_buf, w, rows, work_format());
+        face_state.sdf_target.buf = face_state.tile_buf;
+        face_state.sdf_target.clip = (lv_area_t){0, 0, w - 1, rows - 1};
+        face_state.sdf_target.oy = -y0;
+        face_state.tile_y = y0;
+
+        draw_part(part, target);
+        memcpy(band, face_state.tile_buf, stride * rows);
+    }
+    face_state.tile_y = 0;
+}
+
+static void render_part(face_part_t part)
+{
+    lv_obj_t *canvas = part_canvas(part);
+    if (!canvas)
+        return;
+
+    /* Modulo-counter redraws often land on the pose already on screen */
+    face_pose_t pose;
+    pose_capture(part, &pose);
+    if (face_state.pose_valid[part] && memcmp(&pose, &face_state.pose[part], sizeof(pose)) == 0)
+        return;
+    face_state.pose[part] = pose;
+    face_state.pose_valid[part] = true;
+
+    /* In-place modes draw over the previous frame, so a back buffer that
+     * missed a direct update must catch up with the displayed one first */
+    if (face_state.back_buf[part] && face_state.back_stale[part])
+    {
+        memcpy(face_state.back_buf[part], part_buf(part), part_buf_size(part));
+        face_state.back_stale[part] = false;
+    }
+
+    face_render_mode_t mode = face_state.config.render_mode;
+    bool packed = render_is_packed();
+    uint16_t w, h;
+    part_size(part, &w, &h);
+
+    /* Render through the hidden canvas so that LVGL does not invalidate the
+     * whole visible canvas; packed modes render into the shared scratch,
+     * the others in place. */
+    lv_obj_t *target = face_state.render_canvas;
+    uint8_t *work_buf = packed ? (uint8_t *)face_state.scratch_buf : part_target(part);
+    lv_canvas_set_buffer(target, work_buf, w, h, work_format());
+
+    if (mode == FACE_RENDER_ARGB8888 && area_clip(&face_state.painted[part], w, h))
+        argb8888_clear(work_buf, w, &face_state.painted[part]);
+
+    face_state.sdf_target.buf = work_buf;
+    face_state.sdf_target.stride = lv_draw_buf_width_to_stride(w, work_format());
+    face_state.sdf_target.cf = work_format();
+    face_state.sdf_target.clip = (lv_area_t){0, 0, w - 1, h - 1};
+    face_state.sdf_target.ox = 0;
+    face_state.sdf_target.oy = 0;
+    face_state.sdf_target.sub_x = 0;
+    face_state.sdf_target.sub_y = q8_frac16(face_state.bounce_q8);
+
+    area_set_empty(&face_state.paint_area);
+
+    if (face_state.tile_buf && FACE_PTR_IN_PSRAM(work_buf))
+        draw_part_tiled(part, target, work_buf, w, h);
+    else
+        draw_part(part, target);
+
+    lv_area_t changed = {0, 0, w - 1, h - 1};
+    if (mode == FACE_RENDER_MONO)
+    {
+        if (!mono_pack(part, &changed))
+            return;
+    }
+    else if (render_is_transparent())
+    {
+        /* Old and new painted boxes together cover every pixel that can
+         * differ from the previous frame. */
+        lv_area_t painted = face_state.paint_area;
+        changed = face_state.painted[part];
+        area_join(&changed, &painted);
+        face_state.painted[part] = painted;
+        if (!area_clip(&changed, w, h))
+            return;
+
+        if (mode == FACE_RENDER_RGB565A8)
+        {
+            rgb565a8_pack(part, &changed);
+            if (area_clip(&painted, w, h))
+                argb8888_clear(work_buf, w, &painted);
+        }
+    }
+    else if (mode == FACE_RENDER_RGB565_SWAPPED)
+    {
+        rgb565_swap_pack(part, &changed);
+    }
+
+    /* Truncated motion often reproduces the previous frame exactly; only
+     * the rows whose checksum moved are flushed. */
+    flush_changed(part, &changed);
+}
+
+/* Bytes of pixel data the draw layer writes for a part (work format) */
+static size_t part_work_bytes(face_part_t part)
+{
+    uint16_t w, h;
+    part_size(part, &w, &h);
+    return (size_t)lv_draw_buf_width_to_stride(w, work_format()) * h;
+}
+
+static void invalidate_part(face_part_t part)
+{
+    lv_obj_t *canvas = part_canvas(part);
+#if FACE_LVGL_VERSION_AT_LEAST(9, 1)
+    lv_image_cache_drop(lv_canvas_get_image(canvas));
+#endif
+    lv_obj_invalidate(canvas);
+    for (int m = 0; m < FACE_MAX_MIRRORS; m++)
+    {
+        if (face_state.mirror_imgs[m][part])
+            lv_obj_invalidate(face_state.mirror_imgs[m][part]);
+    }
+    face_state.row_sums_valid[part] = false;
+    face_state.pose_valid[part] = false;
+    face_state.back_stale[part] = true;
+    face_state.frame_changed = true;
+}
+
+/* True if an opaque, visible object drawn after `obj` in `parent` fully
+ * covers `area` (a menu or dialog opened over the face) */
+static bool covered_by_later_sibling(lv_obj_t *parent, int32_t after, const lv_area_t *area)
+{
+    uint32_t count = lv_obj_get_child_count(parent);
+
+    for (uint32_t i = (uint32_t)(after + 1); i < count; i++)
+    {
+        lv_obj_t *sib = lv_obj_get_child(parent, (int32_t)i);
+        if (lv_obj_has_flag(sib, LV_OBJ_FLAG_HIDDEN) ||
+            lv_obj_get_style_bg_opa(sib, LV_PART_MAIN) < LV_OPA_COVER ||
+            lv_obj_get_style_opa(sib, LV_PART_MAIN) < LV_OPA_COVER)
+            continue;
+
+        lv_area_t coords;
+        lv_obj_get_coords(sib, &coords);
+        if (lv_area_is_in(area, &coords, lv_obj_get_style_radius(sib, LV_PART_MAIN)))
+            return true;
+    }
+    return false;
+}
+
+/*
+ * Whether `obj` can currently be seen: not hidden (itself or an ancestor),
+ * on its display's active screen and inside its parents' clip
+ * (lv_obj_is_visible), and not fully covered by an opaque object stacked
+ * above it or on the display's top layer.
+ */
+static bool obj_is_shown(lv_obj_t *obj)
+{
+    if (!obj || !lv_obj_is_visible(obj))
+        return false;
+
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+
+    for (lv_obj_t *o = obj; lv_obj_get_parent(o); o = lv_obj_get_parent(o))
+    {
+        if (covered_by_later_sibling(lv_obj_get_parent(o), lv_obj_get_index(o), &area))
+            return false;
+    }
+
+    lv_obj_t *top = lv_display_get_layer_top(lv_obj_get_display(obj));
+    return !top || !covered_by_later_sibling(top, -1, &area);
+}
+
+/* Rendering is pointless unless the face or one of its mirrors is seen */
+static bool face_is_shown(void)
+{
+    if (obj_is_shown(face_state.face_container))
+        return true;
+
+    for (int m = 0; m < FACE_MAX_MIRRORS; m++)
+    {
+        if (obj_is_shown(face_state.mirrors[m]))
+            return true;
+    }
+    return false;
+}
+
+/* Cross-fades blend cached frames in place, so they need canvases that hold
+ * the work format directly; packed modes fall back to parametric. */
+static bool crossfade_available(void)
+{
+    if (face_state.config.transition != FACE_TRANSITION_CROSSFADE ||
+        face_state.config.update_policy != FACE_UPDATE_CONTINUOUS)
+        return false;
+    if (canvas_format() != work_format())
+        return false;
+    if (!face_is_shown())
+        return false;
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        if (!face_state.fade_src[p])
+            face_state.fade_src[p] = FACE_MALLOC_CANVAS(part_work_bytes((face_part_t)p));
+        if (!face_state.fade_dst[p])
+            face_state.fade_dst[p] = FACE_MALLOC_CANVAS(part_work_bytes((face_part_t)p));
+        if (!face_state.fade_src[p] || !face_state.fade_dst[p])
+        {
+            FACE_LOGW(TAG, "No memory for cross-fade buffers, using parametric transition");
+            return false;
+        }
+    }
+    return true;
+}
+
+/* RGB565 cross-fade; each pixel is spread over one 32-bit word so that all
+ * three channels blend with a single multiply */
+static void crossfade_rgb565(uint16_t *out, const uint16_t *src, const uint16_t *dst, size_t n, uint32_t a)
+{
+    uint32_t a5 = (a + 4) >> 3;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t s = (src[i] | ((uint32_t)src[i] << 16)) & 0x07E0F81F;
+        uint32_t d = (dst[i] | ((uint32_t)dst[i] << 16)) & 0x07E0F81F;
+        s = ((((d - s) * a5) >> 5) + s) & 0x07E0F81F;
+        out[i] = (uint16_t)(s | (s >> 16));
+    }
+}
+
+static void crossfade_bytes(uint8_t *out, const uint8_t *src, const uint8_t *dst, size_t n, uint32_t a)
+{
+    int32_t a256 = (int32_t)(a + (a >> 7));
+
+    for (size_t i = 0; i < n; i++)
+        out[i] = (uint8_t)(src[i] + (((dst[i] - src[i]) * a256) >> 8));
+}
+
+/* Stop a cross-fade where it stands, for a frame that replaces it outright */
+static void crossfade_end(void)
+{
+    if (!face_state.crossfading)
+        return;
+
+    face_state.crossfading = false;
+    /* The blend touched the union of both frames; clear it all next time */
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        uint16_t w, h;
+        part_size((face_part_t)p, &w, &h);
+        face_state.painted[p] = (lv_area_t){0, 0, w - 1, h - 1};
+    }
+}
+
+/*
+ * Render the current state into fade_dst without touching the canvases,
+ * the way a budgeted frame renders into its back buffers but with nothing
+ * queued for a commit.  A budgeted frame still in progress is dropped: the
+ * fade replaces it.
+ */
+static void crossfade_render_target(void)
+{
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        uint8_t *back = face_state.back_buf[p];
+        uint32_t *sums = face_state.row_sums[p];
+        uint16_t w, h;
+        part_size((face_part_t)p, &w, &h);
+
+        /* Draw each part in full: the pose and painted box on record may
+         * describe a back buffer rather than the canvas */
+        face_state.pose_valid[p] = false;
+        face_state.painted[p] = (lv_area_t){0, 0, w - 1, h - 1};
+        face_state.back_buf[p] = face_state.fade_dst[p];
+        face_state.back_stale[p] = false;
+        face_state.row_sums[p] = NULL;
+        render_part((face_part_t)p);
+
+        face_state.back_buf[p] = back;
+        face_state.row_sums[p] = sums;
+        face_state.back_stale[p] = true;
+    }
+    face_state.dirty = 0;
+    face_state.frame_pending = 0;
+    face_state.present_mask = 0;
+}
+
+/* Blend on by the time the last step covered, 10% per tick */
+static void crossfade_step(void)
+{
+    uint32_t progress = LV_MIN(face_state.fade_progress + anim_advance(10), 100);
+    if (progress == face_state.fade_progress)
+        return;
+    face_state.fade_progress = (uint8_t)progress;
+
+    uint32_t a = (face_state.fade_progress * 255) / 100;
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        size_t n = part_work_bytes((face_part_t)p);
+        uint8_t *out = part_buf((face_part_t)p);
+
+        if (work_format() == LV_COLOR_FORMAT_RGB565)
+            crossfade_rgb565((uint16_t *)out, (const uint16_t *)face_state.fade_src[p],
+                             (const uint16_t *)face_state.fade_dst[p], n / 2, a);
+        else
+            crossfade_bytes(out, face_state.fade_src[p], face_state.fade_dst[p], n, a);
+
+        invalidate_part((face_part_t)p);
+    }
+
+    if (face_state.fade_progress == 100)
+        crossfade_end();
+}
+
+static uint16_t panel_strip_rows(void)
+{
+    uint16_t rows = face_state.config.panel_strip_rows ? face_state.config.panel_strip_rows : 16;
+    return LV_MIN(rows, FACE_SZ);
+}
+
+/* Wait up to timeout_ms (0: forever) for strip `b` to leave the wire */
+static bool panel_wait(uint8_t b, uint32_t timeout_ms)
+{
+    int64_t deadline = face_time_us() + (int64_t)timeout_ms * 1000;
+    while (face_state.panel_busy[b])
+    {
+        int64_t left_us = deadline - face_time_us();
+        if (timeout_ms && left_us <= 0)
+            return false;
+#ifdef ESP_PLATFORM
+        /* Any completion wakes us; one that was for the other strip, or
+         * signalled before we waited, just goes round once more */
+        xSemaphoreTake(s_panel_sem, timeout_ms ? pdMS_TO_TICKS(left_us / 1000) + 1 : portMAX_DELAY);
+#else
+        sched_yield();
+#endif
+    }
+    return true;
+}
+
+/*
+ * Direct-panel counterpart of render_parts(): the rows and columns spanned
+ * by the parts whose pose changed are composed strip by strip, alternating
+ * between the two strip buffers, and each finished strip is handed to
+ * panel_flush_cb.  The transfer of one strip runs while the next is being
+ * rasterized; a strip only waits if its buffer is still on the wire.
+ */
+static void panel_render(uint8_t mask)
+{
+    lv_area_t band;
+    area_set_empty(&band);
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        if (!(mask & (1u << p)))
+            continue;
+
+        face_pose_t pose;
+        pose_capture((face_part_t)p, &pose);
+        if (face_state.pose_valid[p] && memcmp(&pose, &face_state.pose[p], sizeof(pose)) == 0)
+            continue;
+        face_state.pose[p] = pose;
+        face_state.pose_valid[p] = true;
+
+        uint16_t w, h;
+        int16_t x, y;
+        part_size((face_part_t)p, &w, &h);
+        part_origin((face_part_t)p, &x, &y);
+        lv_area_t rect = {x, y, x + w - 1, y + h - 1};
+        area_join(&band, &rect);
+    }
+    face_state.dirty &= ~mask;
+
+    /* The background between the parts is only sent once per placement */
+    if (face_state.panel_clear)
+    {
+        band = (lv_area_t){0, 0, FACE_SZ - 1, FACE_SZ - 1};
+        face_state.panel_clear = false;
+    }
+    if (!area_clip(&band, FACE_SZ, FACE_SZ))
+        return;
+
+    int32_t w = band.x2 - band.x1 + 1;
+    uint32_t stride = (uint32_t)w * sizeof(uint16_t);
+    uint16_t rows = panel_strip_rows();
+
+    for (int32_t y0 = band.y1; y0 <= band.y2; y0 += rows)
+    {
+        int32_t h = LV_MIN(rows, band.y2 - y0 + 1);
+        uint8_t b = face_state.panel_next;
+        face_state.panel_next ^= 1;
+
+        /* Previous transfer from this buffer may still be running */
+        panel_wait(b, 0);
+
+        face_state.sdf_target = (face_sdf_target_t){
+            .buf = face_state.panel_strip[b],
+            .stride = stride,
+            .cf = LV_COLOR_FORMAT_RGB565,
+            .clip = {0, 0, w - 1, h - 1},
+        };
+        face_sdf_fill(&face_state.sdf_target, lv_color_white(), LV_OPA_COVER);
+
+        lv_area_t strip = {band.x1, y0, band.x2, y0 + h - 1};
+        for (int p = 0; p < FACE_PART_COUNT; p++)
+        {
+            uint16_t pw, ph;
+            int16_t px, py;
+            part_size((face_part_t)p, &pw, &ph);
+            part_origin((face_part_t)p, &px, &py);
+
+            lv_area_t clip = {LV_MAX(px, strip.x1), LV_MAX(py, strip.y1),
+                              LV_MIN(px + pw - 1, strip.x2), LV_MIN(py + ph - 1, strip.y2)};
+            if (clip.x1 > clip.x2 || clip.y1 > clip.y2)
+                continue;
+
+            face_state.sdf_target.ox = px - band.x1;
+            face_state.sdf_target.oy = py - y0;
+            face_state.sdf_target.clip = (lv_area_t){clip.x1 - band.x1, clip.y1 - y0,
+                                                     clip.x2 - band.x1, clip.y2 - y0};
+            face_state.sdf_target.sub_x = 0;
+            face_state.sdf_target.sub_y = q8_frac16(face_state.bounce_q8);
+
+            if (p == FACE_PART_MOUTH)
+                draw_mouth(NULL, face_state.mouth_curve);
+            else
+                draw_eye(NULL, p == FACE_PART_LEFT_EYE ? face_state.left_eye_openness
+                                                       : face_state.right_eye_openness,
+                         p == FACE_PART_LEFT_EYE);
+        }
+
+        if (face_state.config.render_mode == FACE_RENDER_RGB565_SWAPPED)
+        {
+            uint16_t *px = (uint16_t *)face_state.panel_strip[b];
+            for (int32_t i = 0; i < w * h; i++)
+                px[i] = (uint16_t)((px[i] << 8) | (px[i] >> 8));
+        }
+
+        lv_area_t area = {face_state.config.panel_x + strip.x1, face_state.config.panel_y + strip.y1,
+                          face_state.config.panel_x + strip.x2, face_state.config.panel_y + strip.y2};
+        face_state.panel_busy[b] = true;
+        face_state.config.panel_flush_cb(&area, face_state.panel_strip[b],
+                                         face_state.config.panel_user_data);
+    }
+    face_state.frame_changed = true;
+}
+
+/*
+ * LED-matrix counterpart of render_parts(): the whole face is redrawn at
+ * matrix resolution from the pose and flushed only if a pixel changed,
+ * since sub-pixel motion mostly lands on the same LEDs.
+ */
+static void matrix_render(uint8_t mask)
+{
+    face_state.dirty &= ~mask;
+
+    face_matrix_pose_t pose;
+    memset(&pose, 0, sizeof(pose));
+    pose.left_openness = face_state.left_eye_openness;
+    pose.right_openness = face_state.right_eye_openness;
+    pose.mouth_curve = face_state.mouth_curve;
+    pose.left_brow_angle = face_state.left_eyebrow_angle;
+    pose.right_brow_angle = face_state.right_eyebrow_angle;
+    pose.brow_height = face_state.eyebrow_height;
+    pose.blush = face_state.blush_intensity;
+    pose.sparkle = face_state.sparkle_phase;
+    pose.pupil_x_q8 = face_state.pupil_x_q8;
+    pose.pupil_y_q8 = face_state.pupil_y_q8;
+    pose.bounce_q8 = face_state.bounce_q8;
+    pose.hearts = face_state.current_emotion == FACE_LOVE;
+    pose.grit = face_state.current_emotion == FACE_WORKING_HARD;
+
+    uint16_t w = face_state.config.matrix_width;
+    uint16_t h = face_state.config.matrix_height;
+    size_t size = (size_t)w * h * 3;
+    face_matrix_render(face_state.matrix_buf[1], w, h, &pose);
+    if (memcmp(face_state.matrix_buf[1], face_state.matrix_buf[0], size) == 0)
+        return;
+
+    uint8_t *shown = face_state.matrix_buf[1];
+    face_state.matrix_buf[1] = face_state.matrix_buf[0];
+    face_state.matrix_buf[0] = shown;
+    face_state.config.matrix_flush_cb(shown, w, h, face_state.config.matrix_user_data);
+    face_state.frame_changed = true;
+}
+
+/* Render the parts in `mask` (FACE_DIRTY_*) and clear their dirty bits */
+static void render_parts(uint8_t mask)
+{
+    if (panel_mode())
+    {
+        panel_render(mask);
+        return;
+    }
+    if (matrix_mode())
+    {
+        matrix_render(mask);
+        return;
+    }
+
+    /* While nothing shows the face, keep the parts dirty; they render
+     * once it is visible again */
+    if (!face_is_shown())
+    {
+        face_state.dirty |= mask;
+        return;
+    }
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        if (mask & (1u << p))
+            render_part((face_part_t)p);
+    }
+    face_state.dirty &= ~mask;
+
+    /* Direct renders complete a budgeted frame in progress, if any, from
+     * the live state: the canvases it already drew show an older one */
+    face_state.frame_pending &= ~mask;
+    if (face_state.frame_pending)
+    {
+        uint8_t rest = face_state.frame_pending | face_state.present_mask;
+        face_state.frame_pending = 0;
+        for (int p = 0; p < FACE_PART_COUNT; p++)
+        {
+            if (rest & (1u << p))
+                render_part((face_part_t)p);
+        }
+    }
+    commit_frame();
+}
+
+/* Fields of face_frame_t, named as in face_state */
+#define FACE_FRAME_FIELDS(X)                                                  \
+    X(current_emotion) X(left_eye_openness) X(right_eye_openness)             \
+    X(mouth_curve) X(left_eyebrow_angle) X(right_eyebrow_angle)               \
+    X(eyebrow_height) X(blush_intensity) X(bounce_offset) X(sparkle_phase)    \
+    X(heart_beat_phase) X(pupil_offset_x) X(pupil_offset_y) X(bounce_q8)      \
+    X(pupil_x_q8) X(pupil_y_q8) X(diamond_mouth_phase) X(particles)           \
+    X(fx_version)
+
+static void mem_swap(void *a, void *b, size_t n)
+{
+    uint8_t *x = a, *y = b;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint8_t t = x[i];
+        x[i] = y[i];
+        y[i] = t;
+    }
+}
+
+static void frame_capture(face_frame_t *f)
+{
+#define FRAME_COPY(field) memcpy(&f->field, &face_state.field, sizeof(f->field));
+    FACE_FRAME_FIELDS(FRAME_COPY)
+#undef FRAME_COPY
+}
+
+/* Exchange the drawn state with `f`; a second call undoes the first */
+static void frame_swap(face_frame_t *f)
+{
+#define FRAME_SWAP(field) mem_swap(&f->field, &face_state.field, sizeof(f->field));
+    FACE_FRAME_FIELDS(FRAME_SWAP)
+#undef FRAME_SWAP
+}
+
+/*
+ * Budgeted counterpart of render_parts(): the dirty canvases become one
+ * frame that is rendered a canvas at a time, spread over as many ticks as
+ * the budget needs, and published only once every canvas is done.  At
+ * least one canvas renders per tick; another follows only if its last
+ * measured cost still fits the budget.  The logic keeps stepping in the
+ * meantime, so every canvas draws the state captured at the frame start.
+ */
+static void render_sliced(void)
+{
+    if (!face_is_shown())
+        return;
+
+    if (!face_state.frame_pending)
+    {
+        face_state.frame_pending = face_state.dirty;
+        face_state.dirty = 0;
+        frame_capture(face_state.slice_frame);
+    }
+
+    int64_t start = face_time_us();
+    bool rendered = false;
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        if (!(face_state.frame_pending & (1u << p)))
+            continue;
+
+        int64_t t0 = face_time_us();
+        if (rendered && t0 - start + face_state.part_cost_us[p] > face_state.config.render_budget_us)
+            break;
+
+        frame_swap(face_state.slice_frame);
+        render_part((face_part_t)p);
+        frame_swap(face_state.slice_frame);
+        face_state.part_cost_us[p] = (uint32_t)(face_time_us() - t0);
+        face_state.frame_pending &= ~(1u << p);
+        rendered = true;
+    }
+
+    if (!face_state.frame_pending)
+        commit_frame();
+}
+
+static void render_all(void)
+{
+    render_parts(FACE_DIRTY_ALL);
+}
+
+/*
+ * Canvases too big for internal RAM land in PSRAM, where every blend goes
+ * through the cache; give them an internal band to render in
+ */
+static void tile_setup(void)
+{
+    bool psram = FACE_PTR_IN_PSRAM(face_state.scratch_buf);
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        psram |= FACE_PTR_IN_PSRAM(part_buf((face_part_t)p)) ||
+                 FACE_PTR_IN_PSRAM(face_state.back_buf[p]) ||
+                 FACE_PTR_IN_PSRAM(face_state.ahead_buf[0][p]);
+    }
+    if (!psram)
+        return;
+
+    uint16_t w = LV_MAX(FACE_EYE_CW, FACE_MOUTH_CW);
+    size_t size = (size_t)lv_draw_buf_width_to_stride(w, work_format()) * FACE_TILE_ROWS;
+    face_state.tile_buf = FACE_MALLOC_INTERNAL(size);
+    if (face_state.tile_buf)
+        FACE_LOGI(TAG, "Canvases in PSRAM, rendering through a %u-row internal tile", FACE_TILE_ROWS);
+    else
+        FACE_LOGW(TAG, "No internal RAM for a render tile, drawing straight into PSRAM");
+}
+
+/* LVGL output: the container, the part canvases and their side buffers */
+static esp_err_t canvas_setup(void)
+{
+    lv_obj_t *parent_obj = (face_state.config.parent != NULL)
+                               ? face_state.config.parent
+                               : lv_scr_act();
+    lv_obj_update_layout(parent_obj);
+
+    if (face_state.config.render_mode == FACE_RENDER_NATIVE)
+        face_state.config.render_mode = native_render_mode(parent_obj);
+#if !FACE_HAS_RGB565_SWAPPED
+    if (face_state.config.render_mode == FACE_RENDER_RGB565_SWAPPED)
+    {
+        FACE_LOGW(TAG, "RGB565_SWAPPED canvases need LVGL 9.3, using RGB565");
+        face_state.config.render_mode = FACE_RENDER_RGB565;
+    }
+#endif
+
+    int32_t parent_w = lv_obj_get_width(parent_obj);
+    int32_t parent_h = lv_obj_get_height(parent_obj);
+    set_face_size((uint16_t)((parent_w < parent_h) ? parent_w : parent_h));
+    uint16_t face_sz = FACE_SZ;
+
+    FACE_LOGI(TAG, "Parent: %dx%d, face_sz: %u, eye: %upx, mouth: %ux%upx",
+              parent_w, parent_h, face_sz,
+              FACE_EYE_CW, FACE_MOUTH_CW, FACE_MOUTH_CH);
+
+    face_state.face_container = lv_obj_create(parent_obj);
+    lv_obj_set_size(face_state.face_container, face_sz, face_sz);
+    lv_obj_center(face_state.face_container);
+    lv_obj_set_style_bg_opa(face_state.face_container, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(face_state.face_container, 0, 0);
+    lv_obj_set_style_pad_all(face_state.face_container, 0, 0);
+
+    lv_obj_clear_flag(face_state.face_container, LV_OBJ_FLAG_SCROLLABLE);
+
+    face_state.left_eye_buf = FACE_MALLOC_CANVAS(part_buf_size(FACE_PART_LEFT_EYE));
+    face_state.right_eye_buf = FACE_MALLOC_CANVAS(part_buf_size(FACE_PART_RIGHT_EYE));
+    face_state.mouth_buf = FACE_MALLOC_CANVAS(part_buf_size(FACE_PART_MOUTH));
+
+    bool packed = render_is_packed();
+    if (packed)
+    {
+        /* One shared work-format scratch the size of the largest canvas; the
+         * displayed canvases only hold the packed result. */
+        size_t eye_scratch = (size_t)lv_draw_buf_width_to_stride(FACE_EYE_CW, work_format()) *
+                             FACE_EYE_CW;
+        size_t mouth_scratch = (size_t)lv_draw_buf_width_to_stride(FACE_MOUTH_CW, work_format()) *
+                               FACE_MOUTH_CH;
+        size_t scratch_size = eye_scratch > mouth_scratch ? eye_scratch : mouth_scratch;
+        face_state.scratch_buf = FACE_MALLOC_CANVAS(scratch_size);
+        if (face_state.scratch_buf)
+            memset(face_state.scratch_buf, 0, scratch_size);
+    }
+
+    if (!face_state.left_eye_buf || !face_state.right_eye_buf || !face_state.mouth_buf ||
+        (packed && !face_state.scratch_buf))
+    {
+        FACE_LOGE(TAG, "Failed to allocate canvas buffers");
+        return ESP_ERR_NO_MEM;
+    }
+
+    int16_t left_eye_x, right_eye_x, eye_y, mouth_x, mouth_y;
+    part_origin(FACE_PART_LEFT_EYE, &left_eye_x, &eye_y);
+    part_origin(FACE_PART_RIGHT_EYE, &right_eye_x, &eye_y);
+    part_origin(FACE_PART_MOUTH, &mouth_x, &mouth_y);
+
+    lv_color_format_t cf = canvas_format();
+
+    face_state.left_eye_canvas = lv_canvas_create(face_state.face_container);
+    lv_canvas_set_buffer(face_state.left_eye_canvas, face_state.left_eye_buf,
+                         FACE_EYE_CW, FACE_EYE_CW, cf);
+    lv_obj_set_pos(face_state.left_eye_canvas, left_eye_x, eye_y);
+
+    face_state.right_eye_canvas = lv_canvas_create(face_state.face_container);
+    lv_canvas_set_buffer(face_state.right_eye_canvas, face_state.right_eye_buf,
+                         FACE_EYE_CW, FACE_EYE_CW, cf);
+    lv_obj_set_pos(face_state.right_eye_canvas, right_eye_x, eye_y);
+
+    face_state.mouth_canvas = lv_canvas_create(face_state.face_container);
+    lv_canvas_set_buffer(face_state.mouth_canvas, face_state.mouth_buf,
+                         FACE_MOUTH_CW, FACE_MOUTH_CH, cf);
+    lv_obj_set_pos(face_state.mouth_canvas, mouth_x, mouth_y);
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        uint16_t w, h;
+        part_size((face_part_t)p, &w, &h);
+
+        area_set_empty(&face_state.painted[p]);
+        if (face_state.config.render_mode != FACE_RENDER_RGB565)
+            memset(part_buf((face_part_t)p), 0, part_buf_size((face_part_t)p));
+
+        /* Mono packing diffs exactly already; elsewhere a failed allocation
+         * only means every redraw flushes its full box. */
+        if (face_state.config.render_mode != FACE_RENDER_MONO)
+            face_state.row_sums[p] = malloc(h * sizeof(uint32_t));
+        face_state.row_sums_valid[p] = false;
+    }
+
+    if (face_state.config.render_budget_us > 0)
+    {
+        for (int p = 0; p < FACE_PART_COUNT; p++)
+        {
+            face_state.back_buf[p] = FACE_MALLOC_CANVAS(part_buf_size((face_part_t)p));
+            face_state.back_stale[p] = true;
+        }
+        face_state.slice_frame = malloc(sizeof(face_frame_t));
+        if (!face_state.back_buf[FACE_PART_LEFT_EYE] || !face_state.back_buf[FACE_PART_RIGHT_EYE] ||
+            !face_state.back_buf[FACE_PART_MOUTH] || !face_state.slice_frame)
+        {
+            FACE_LOGW(TAG, "No memory for back buffers, rendering without a budget");
+            for (int p = 0; p < FACE_PART_COUNT; p++)
+            {
+                free(face_state.back_buf[p]);
+                face_state.back_buf[p] = NULL;
+            }
+            free(face_state.slice_frame);
+            face_state.slice_frame = NULL;
+        }
+    }
+
+    if (face_state.config.lookahead_frames > 0)
+    {
+        /* Predicted frames are whole canvases presented by copy, which only
+         * works for canvases rendered in full each time they change */
+        if (render_is_transparent() || canvas_format() != work_format() ||
+            face_state.config.update_policy != FACE_UPDATE_CONTINUOUS ||
+            face_state.back_buf[FACE_PART_LEFT_EYE])
+        {
+            FACE_LOGW(TAG, "Lookahead needs RGB565, RGB888 or XRGB8888, continuous updates and no render budget, disabled");
+        }
+        else
+        {
+            uint8_t frames = LV_MIN(face_state.config.lookahead_frames, FACE_MAX_LOOKAHEAD);
+            uint8_t len = 0;
+            for (; len < frames; len++)
+            {
+                for (int p = 0; p < FACE_PART_COUNT; p++)
+                    face_state.ahead_buf[len][p] = FACE_MALLOC_CANVAS(part_work_bytes((face_part_t)p));
+                if (!face_state.ahead_buf[len][FACE_PART_LEFT_EYE] ||
+                    !face_state.ahead_buf[len][FACE_PART_RIGHT_EYE] ||
+                    !face_state.ahead_buf[len][FACE_PART_MOUTH])
+                    break;
+            }
+            if (len > 0)
+                s_ahead_sim = malloc(sizeof(face_state_t));
+            if (!s_ahead_sim)
+                len = 0;
+            if (len < frames)
+                FACE_LOGW(TAG, "No memory for lookahead, %u of %u frames", len, frames);
+            face_state.ahead_len = len;
+        }
+    }
+
+    if (face_state.config.render_mode == FACE_RENDER_MONO)
+    {
+        for (int p = 0; p < FACE_PART_COUNT; p++)
+        {
+            lv_obj_t *canvas = part_canvas((face_part_t)p);
+            lv_canvas_set_palette(canvas, 0, lv_color_to_32(lv_color_white(), LV_OPA_COVER));
+            lv_canvas_set_palette(canvas, 1, lv_color_to_32(lv_color_black(), LV_OPA_COVER));
+        }
+    }
+
+    face_state.render_canvas = lv_canvas_create(face_state.face_container);
+    lv_obj_add_flag(face_state.render_canvas, LV_OBJ_FLAG_HIDDEN);
+
+    lv_obj_update_layout(face_state.face_container);
+
+    tile_setup();
+    return ESP_OK;
+}
+
+/*
+ * Direct-panel output: no LVGL objects at all, only the two strip buffers
+ * in DMA-capable memory.  Strips are always RGB565 drawn by the SDF (or
+ * mesh) backend, which can target raw memory.
+ */
+static esp_err_t panel_setup(void)
+{
+    face_config_t *cfg = &face_state.config;
+#ifdef FACE_FIXED_SIZE
+    if (!cfg->panel_size)
+        cfg->panel_size = FACE_FIXED_SIZE;
+#endif
+    if (!cfg->panel_size)
+    {
+        FACE_LOGE(TAG, "Direct-panel output needs panel_size");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!backend_is_sdf())
+        cfg->backend = FACE_BACKEND_SDF;
+    if (cfg->render_mode != FACE_RENDER_RGB565 && cfg->render_mode != FACE_RENDER_RGB565_SWAPPED)
+    {
+        FACE_LOGW(TAG, "Direct-panel output sends RGB565, ignoring render mode");
+        cfg->render_mode = FACE_RENDER_RGB565;
+    }
+    if (cfg->sync_to_refresh || cfg->render_budget_us || cfg->lookahead_frames ||
+        cfg->transition == FACE_TRANSITION_CROSSFADE)
+    {
+        FACE_LOGW(TAG, "Refresh sync, render budget, lookahead and cross-fade need canvases, disabled");
+        cfg->sync_to_refresh = false;
+        cfg->render_budget_us = 0;
+        cfg->lookahead_frames = 0;
+        cfg->transition = FACE_TRANSITION_PARAMETRIC;
+    }
+
+    set_face_size(cfg->panel_size);
+    face_state.panel_clear = true;
+
+    size_t strip_size = (size_t)FACE_SZ * panel_strip_rows() * sizeof(uint16_t);
+    face_state.panel_strip[0] = FACE_MALLOC_DMA(strip_size);
+    face_state.panel_strip[1] = FACE_MALLOC_DMA(strip_size);
+    if (!face_state.panel_strip[0] || !face_state.panel_strip[1])
+    {
+        FACE_LOGE(TAG, "Failed to allocate panel strips");
+        free(face_state.panel_strip[0]);
+        free(face_state.panel_strip[1]);
+        face_state.panel_strip[0] = NULL;
+        face_state.panel_strip[1] = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+#ifdef ESP_PLATFORM
+    /* Created once and kept: a strip deinit gave up on may still complete */
+    if (!s_panel_sem)
+        s_panel_sem = xSemaphoreCreateBinary();
+    if (!s_panel_sem)
+    {
+        FACE_LOGE(TAG, "Failed to create the panel semaphore");
+        return ESP_ERR_NO_MEM;
+    }
+#endif
+
+    FACE_LOGI(TAG, "Panel output: face_sz %u at (%d, %d), 2 strips of %u rows",
+              FACE_SZ, cfg->panel_x, cfg->panel_y, panel_strip_rows());
+    return ESP_OK;
+}
+
+/*
+ * LED-matrix output: two small RGB888 frames and nothing from LVGL; the
+ * caller steps the face through face_animation_update().
+ */
+static esp_err_t matrix_setup(void)
+{
+    face_config_t *cfg = &face_state.config;
+    if (!cfg->matrix_width || !cfg->matrix_height)
+    {
+        FACE_LOGE(TAG, "LED-matrix output needs matrix_width and matrix_height");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    cfg->sync_to_refresh = false;
+    cfg->render_budget_us = 0;
+    cfg->lookahead_frames = 0;
+    cfg->transition = FACE_TRANSITION_PARAMETRIC;
+#ifndef FACE_FIXED_SIZE
+    set_face_size(LV_MIN(cfg->matrix_width, cfg->matrix_height));
+#endif
+
+    size_t size = (size_t)cfg->matrix_width * cfg->matrix_height * 3;
+    face_state.matrix_buf[0] = malloc(size);
+    face_state.matrix_buf[1] = malloc(size);
+    if (!face_state.matrix_buf[0] || !face_state.matrix_buf[1])
+    {
+        FACE_LOGE(TAG, "Failed to allocate matrix frames");
+        free(face_state.matrix_buf[0]);
+        free(face_state.matrix_buf[1]);
+        face_state.matrix_buf[0] = NULL;
+        face_state.matrix_buf[1] = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    /* Nothing matches the first frame, so it is always flushed */
+    memset(face_state.matrix_buf[0], 0xFF, size);
+
+    FACE_LOGI(TAG, "Matrix output: %ux%u", cfg->matrix_width, cfg->matrix_height);
+    return ESP_OK;
+}
+
+esp_err_t face_animation_init(face_config_t *config)
+{
+    if (face_state.initialized)
+    {
+        FACE_LOGW(TAG, "Face animation already initialized");
+        return ESP_OK;
+    }
+
+    s_face_headless = config && config->matrix_flush_cb;
+    face_lock();
+
+    if (config != NULL)
+    {
+        face_state.config = *config;
+    }
+    else
+    {
+        face_state.config.parent = NULL;
+        face_state.config.animation_speed = DEFAULT_ANIM_SPEED_MS;
+        face_state.config.blink_interval = DEFAULT_BLINK_INTERVAL;
+        face_state.config.auto_blink = true;
+    }
+
+    esp_err_t err = panel_mode() ? panel_setup() : matrix_mode() ? matrix_setup() : canvas_setup();
+    if (err != ESP_OK)
+    {
+        face_unlock();
+        return err;
+    }
+
+    face_state.current_emotion = FACE_NEUTRAL;
+    face_state.target_emotion = FACE_NEUTRAL;
+    face_state.left_eye_openness = 100;
+    face_state.right_eye_openness = 100;
+    face_state.mouth_curve = 0;
+    face_state.left_eyebrow_angle = 0;
+    face_state.right_eyebrow_angle = 0;
+    face_state.eyebrow_height = 0;
+    face_state.transition_progress = 100;
+    face_state.last_blink_time = face_now_ms();
+
+    face_state.blush_intensity = 0;
+    face_state.bounce_offset = 0;
+    face_state.sparkle_phase = 0;
+    face_state.heart_beat_phase = 0;
+    face_state.keyframe_emotion = FACE_NEUTRAL;
+    face_state.keyframe_closed = false;
+    face_state.diamond_direction = 1;
+    face_state.heart_direction = -1;
+    face_state.step_time = face_state.last_blink_time;
+
+    render_all();
+
+    if (face_state.config.sync_to_refresh)
+    {
+        face_state.sync_disp = lv_obj_get_display(face_state.face_container);
+        face_state.sync_last = lv_tick_get();
+        lv_display_add_event_cb(face_state.sync_disp, refr_start_cb, LV_EVENT_REFR_START, NULL);
+        face_state.sync_timer = lv_timer_create(sync_wake_cb, sync_period(), NULL);
+    }
+    else if (!matrix_mode())
+    {
+        face_state.anim_timer = lv_timer_create(animation_timer_cb,
+                                                face_state.config.animation_speed,
+                                                NULL);
+    }
+
+    face_unlock();
+
+    face_state.initialized = true;
+    FACE_LOGI(TAG, "Face animation initialized successfully");
+
+    return ESP_OK;
+}
+
+/* Four lashes rising from a closed lid at `lid_y` */
+static void draw_lashes(lv_layer_t *layer, int16_t center_x, int16_t lid_y, int16_t eye_width, bool is_left)
+{
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.color = lv_color_black();
+    line_dsc.width = 2;
+    line_dsc.opa = LV_OPA_COVER;
+    line_dsc.round_start = 1;
+    line_dsc.round_end = 1;
+
+    for (int i = 0; i < 4; i++)
+    {
+        int16_t x = center_x - eye_width / 3 + (eye_width * i / 4);
+        int16_t lash_length = 6;
+
+        line_dsc.p1.x = x;
+        line_dsc.p1.y = lid_y;
+        line_dsc.p2.x = x + (is_left ? -2 : 2);
+        line_dsc.p2.y = lid_y - lash_length;
+        face_draw_line(layer, &line_dsc);
+    }
+}
+
+static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
+{
+    /* Without a canvas the SDF backend still draws into sdf_target */
+    if (!canvas && !backend_is_sdf())
+        return;
+
+    uint16_t width = FACE_EYE_CW;
+    uint16_t height = FACE_EYE_CW;
+
+    canvas_clear(canvas);
+
+    lv_layer_t layer;
+    if (canvas)
+        lv_canvas_init_layer(canvas, &layer);
+
+    int16_t eye_width = width * 0.75;
+    int16_t eye_height = (eye_width * openness) / 100;
+    if (eye_height < 8)
+        eye_height = 8;
+    int16_t center_x = width / 2;
+    int16_t center_y = (height * 0.6) + face_state.bounce_offset;
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.color = lv_color_make(80, 60, 40);
+    line_dsc.width = 4;
+    line_dsc.opa = LV_OPA_COVER;
+
+    int8_t eyebrow_angle = is_left ? face_state.left_eyebrow_angle : face_state.right_eyebrow_angle;
+    int16_t eyebrow_y = center_y - eye_width / 2 - 6 + face_state.eyebrow_height;
+    int16_t eyebrow_width = eye_width * 0.9;
+
+    int16_t y_offset = eyebrow_width * face_sin_q15(FACE_TRIG_DEG(eyebrow_angle)) / (4 * 32768);
+
+    line_dsc.round_start = 1;
+    line_dsc.round_end = 1;
+
+    if (is_left)
+    {
+        line_dsc.p1.x = center_x - eyebrow_width * 0.5;
+        line_dsc.p1.y = eyebrow_y - y_offset;
+        line_dsc.p2.x = center_x + eyebrow_width * 0.5;
+        line_dsc.p2.y = eyebrow_y + y_offset;
+    }
+    else
+    {
+        line_dsc.p1.x = center_x - eyebrow_width * 0.5;
+        line_dsc.p1.y = eyebrow_y + y_offset;
         line_dsc.p2.x = center_x + eyebrow_width * 0.5;
         line_dsc.p2.y = eyebrow_y - y_offset;
     }
 
-    lv_draw_line(&layer, &line_dsc);
+    face_draw_line(&layer, &line_dsc);
 
     if (face_state.blush_intensity > 0)
     {
@@ -325,7 +2383,7 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
         blush_area.x2 = center_x + 10;
         blush_area.y2 = center_y + eye_width / 2 + 8;
 
-        lv_draw_rect(&layer, &blush_dsc, &blush_area);
+        face_draw_rect(&layer, &blush_dsc, &blush_area);
     }
 
     lv_draw_rect_dsc_t rect_dsc;
@@ -341,70 +2399,77 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
         rect_dsc.bg_opa = LV_OPA_COVER;
         rect_dsc.border_width = 0;
 
-        rect_dsc.radius = heart_size * 0.18;
-        lv_area_t bottom_tip;
-        bottom_tip.x1 = center_x - heart_size * 0.08;
-        bottom_tip.y1 = center_y + heart_size * 0.35;
-        bottom_tip.x2 = center_x + heart_size * 0.08;
-        bottom_tip.y2 = center_y + heart_size * 0.52;
-        lv_draw_rect(&layer, &rect_dsc, &bottom_tip);
-
-        rect_dsc.radius = heart_size * 0.15;
-        lv_area_t lower_mid;
-        lower_mid.x1 = center_x - heart_size * 0.22;
-        lower_mid.y1 = center_y + heart_size * 0.12;
-        lower_mid.x2 = center_x + heart_size * 0.22;
-        lower_mid.y2 = center_y + heart_size * 0.42;
-        lv_draw_rect(&layer, &rect_dsc, &lower_mid);
-
-        rect_dsc.radius = heart_size * 0.12;
-        lv_area_t upper_mid;
-        upper_mid.x1 = center_x - heart_size * 0.38;
-        upper_mid.y1 = center_y - heart_size * 0.12;
-        upper_mid.x2 = center_x + heart_size * 0.38;
-        upper_mid.y2 = center_y + heart_size * 0.22;
-        lv_draw_rect(&layer, &rect_dsc, &upper_mid);
-
-        rect_dsc.radius = LV_RADIUS_CIRCLE;
-        int16_t bump_size = heart_size * 0.32;
-
-        lv_area_t left_bump;
-        left_bump.x1 = center_x - heart_size * 0.24 - bump_size;
-        left_bump.y1 = center_y - heart_size * 0.28 - bump_size;
-        left_bump.x2 = center_x - heart_size * 0.24 + bump_size;
-        left_bump.y2 = center_y - heart_size * 0.28 + bump_size;
-        lv_draw_rect(&layer, &rect_dsc, &left_bump);
-
-        lv_area_t right_bump;
-        right_bump.x1 = center_x + heart_size * 0.24 - bump_size;
-        right_bump.y1 = center_y - heart_size * 0.28 - bump_size;
-        right_bump.x2 = center_x + heart_size * 0.24 + bump_size;
-        right_bump.y2 = center_y - heart_size * 0.28 + bump_size;
-        lv_draw_rect(&layer, &rect_dsc, &right_bump);
-
-        rect_dsc.radius = heart_size * 0.14;
-        lv_area_t center_fill;
-        center_fill.x1 = center_x - heart_size * 0.12;
-        center_fill.y1 = center_y - heart_size * 0.32;
-        center_fill.x2 = center_x + heart_size * 0.12;
-        center_fill.y2 = center_y - heart_size * 0.05;
-        lv_draw_rect(&layer, &rect_dsc, &center_fill);
-
-        rect_dsc.radius = heart_size * 0.16;
-
-        lv_area_t left_smooth;
-        left_smooth.x1 = center_x - heart_size * 0.42;
-        left_smooth.y1 = center_y - heart_size * 0.08;
-        left_smooth.x2 = center_x - heart_size * 0.25;
-        left_smooth.y2 = center_y + heart_size * 0.18;
-        lv_draw_rect(&layer, &rect_dsc, &left_smooth);
-
-        lv_area_t right_smooth;
-        right_smooth.x1 = center_x + heart_size * 0.25;
-        right_smooth.y1 = center_y - heart_size * 0.08;
-        right_smooth.x2 = center_x + heart_size * 0.42;
-        right_smooth.y2 = center_y + heart_size * 0.18;
-        lv_draw_rect(&layer, &rect_dsc, &right_smooth);
+        if (backend_is_sdf())
+        {
+            face_draw_heart(center_x, center_y + heart_size * 0.52, heart_size, heart_color, LV_OPA_COVER);
+        }
+        else
+        {
+            rect_dsc.radius = heart_size * 0.18;
+            lv_area_t bottom_tip;
+            bottom_tip.x1 = center_x - heart_size * 0.08;
+            bottom_tip.y1 = center_y + heart_size * 0.35;
+            bottom_tip.x2 = center_x + heart_size * 0.08;
+            bottom_tip.y2 = center_y + heart_size * 0.52;
+            face_draw_rect(&layer, &rect_dsc, &bottom_tip);
+
+            rect_dsc.radius = heart_size * 0.15;
+            lv_area_t lower_mid;
+            lower_mid.x1 = center_x - heart_size * 0.22;
+            lower_mid.y1 = center_y + heart_size * 0.12;
+            lower_mid.x2 = center_x + heart_size * 0.22;
+            lower_mid.y2 = center_y + heart_size * 0.42;
+            face_draw_rect(&layer, &rect_dsc, &lower_mid);
+
+            rect_dsc.radius = heart_size * 0.12;
+            lv_area_t upper_mid;
+            upper_mid.x1 = center_x - heart_size * 0.38;
+            upper_mid.y1 = center_y - heart_size * 0.12;
+            upper_mid.x2 = center_x + heart_size * 0.38;
+            upper_mid.y2 = center_y + heart_size * 0.22;
+            face_draw_rect(&layer, &rect_dsc, &upper_mid);
+
+            rect_dsc.radius = LV_RADIUS_CIRCLE;
+            int16_t bump_size = heart_size * 0.32;
+
+            lv_area_t left_bump;
+            left_bump.x1 = center_x - heart_size * 0.24 - bump_size;
+            left_bump.y1 = center_y - heart_size * 0.28 - bump_size;
+            left_bump.x2 = center_x - heart_size * 0.24 + bump_size;
+            left_bump.y2 = center_y - heart_size * 0.28 + bump_size;
+            face_draw_rect(&layer, &rect_dsc, &left_bump);
+
+            lv_area_t right_bump;
+            right_bump.x1 = center_x + heart_size * 0.24 - bump_size;
+            right_bump.y1 = center_y - heart_size * 0.28 - bump_size;
+            right_bump.x2 = center_x + heart_size * 0.24 + bump_size;
+            right_bump.y2 = center_y - heart_size * 0.28 + bump_size;
+            face_draw_rect(&layer, &rect_dsc, &right_bump);
+
+            rect_dsc.radius = heart_size * 0.14;
+            lv_area_t center_fill;
+            center_fill.x1 = center_x - heart_size * 0.12;
+            center_fill.y1 = center_y - heart_size * 0.32;
+            center_fill.x2 = center_x + heart_size * 0.12;
+            center_fill.y2 = center_y - heart_size * 0.05;
+            face_draw_rect(&layer, &rect_dsc, &center_fill);
+
+            rect_dsc.radius = heart_size * 0.16;
+
+            lv_area_t left_smooth;
+            left_smooth.x1 = center_x - heart_size * 0.42;
+            left_smooth.y1 = center_y - heart_size * 0.08;
+            left_smooth.x2 = center_x - heart_size * 0.25;
+            left_smooth.y2 = center_y + heart_size * 0.18;
+            face_draw_rect(&layer, &rect_dsc, &left_smooth);
+
+            lv_area_t right_smooth;
+            right_smooth.x1 = center_x + heart_size * 0.25;
+            right_smooth.y1 = center_y - heart_size * 0.08;
+            right_smooth.x2 = center_x + heart_size * 0.42;
+            right_smooth.y2 = center_y + heart_size * 0.18;
+            face_draw_rect(&layer, &rect_dsc, &right_smooth);
+        }
 
         rect_dsc.bg_color = lv_color_white();
         rect_dsc.bg_opa = LV_OPA_80;
@@ -417,7 +2482,7 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
         highlight.y1 = center_y - heart_size * 0.2 - hl_size / 2;
         highlight.x2 = center_x - heart_size * 0.2 + hl_size / 2;
         highlight.y2 = center_y - heart_size * 0.2 + hl_size / 2;
-        lv_draw_rect(&layer, &rect_dsc, &highlight);
+        face_draw_rect(&layer, &rect_dsc, &highlight);
 
         rect_dsc.bg_opa = LV_OPA_60;
         int16_t hl_small = heart_size * 0.12;
@@ -425,7 +2490,7 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
         highlight.y1 = center_y - heart_size * 0.12 - hl_small / 2;
         highlight.x2 = center_x + heart_size * 0.05 + hl_small / 2;
         highlight.y2 = center_y - heart_size * 0.12 + hl_small / 2;
-        lv_draw_rect(&layer, &rect_dsc, &highlight);
+        face_draw_rect(&layer, &rect_dsc, &highlight);
 
         if (face_state.sparkle_phase > 0)
         {
@@ -435,10 +2500,10 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
 
             for (int i = 0; i < 6; i++)
             {
-                float angle = (i * 60 + face_state.sparkle_phase * 5) * 3.14159 / 180.0;
+                uint16_t angle = FACE_TRIG_DEG(i * 60 + face_state.sparkle_phase * 5);
                 int16_t spark_dist = heart_size * 0.6;
-                int16_t spark_x = center_x + spark_dist * cos(angle);
-                int16_t spark_y = center_y + spark_dist * sin(angle) * 0.85;
+                int16_t spark_x = center_x + spark_dist * face_cos_q15(angle) / 32768;
+                int16_t spark_y = center_y + spark_dist * face_sin_q15(angle) * 17 / (20 * 32768);
 
                 lv_area_t spark_area;
                 spark_area.x1 = spark_x - 2;
@@ -446,11 +2511,11 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
                 spark_area.x2 = spark_x + 2;
                 spark_area.y2 = spark_y + 2;
 
-                lv_draw_rect(&layer, &rect_dsc, &spark_area);
+                face_draw_rect(&layer, &rect_dsc, &spark_area);
             }
         }
     }
-    else if (openness > 20)
+    else if (openness > 20 || backend_is_mesh())
     {
 
         rect_dsc.bg_color = lv_color_white();
@@ -466,7 +2531,24 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
         eye_area.x2 = center_x + eye_width / 2;
         eye_area.y2 = center_y + eye_height / 2;
 
-        lv_draw_rect(&layer, &rect_dsc, &eye_area);
+        if (backend_is_mesh())
+        {
+            /* Lids close by weight, not by a clamped box height, so the
+             * same outline runs from wide open to a shut arc; a blushing
+             * cheek pushes the lower lid up */
+            uint16_t weights[FACE_EYE_SHAPE_COUNT] = {
+                [FACE_EYE_CLOSE] = (uint16_t)(FACE_MESH_ONE - (openness * FACE_MESH_ONE) / 100),
+                [FACE_EYE_SQUINT] = (uint16_t)((face_state.blush_intensity * FACE_MESH_ONE) / 300),
+            };
+            face_draw_mesh(face_mesh_eye(), weights, center_x * 16 + 8, center_y * 16 + 8,
+                           eye_width * 8, eye_width * 8, lv_color_white(), LV_OPA_COVER, 3, &eye_area);
+            eye_height = eye_area.y2 - eye_area.y1;
+            center_y = (eye_area.y1 + eye_area.y2) / 2;
+        }
+        else
+        {
+            face_draw_rect(&layer, &rect_dsc, &eye_area);
+        }
 
         if (openness > 30 && eye_height > 16)
         {
@@ -477,24 +2559,35 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
 
             int16_t iris_center_x = center_x + face_state.pupil_offset_x;
             int16_t iris_center_y = center_y + face_state.pupil_offset_y;
+            int32_t iris_sub_x = q8_frac16(face_state.pupil_x_q8);
+            int32_t iris_sub_y = q8_frac16(face_state.pupil_y_q8);
 
             if (iris_center_x - iris_width / 2 < center_x - eye_width / 2 + 3)
             {
                 iris_center_x = center_x - eye_width / 2 + iris_width / 2 + 3;
+                iris_sub_x = 0;
             }
             if (iris_center_x + iris_width / 2 > center_x + eye_width / 2 - 3)
             {
                 iris_center_x = center_x + eye_width / 2 - iris_width / 2 - 3;
+                iris_sub_x = 0;
             }
             if (iris_center_y - iris_height / 2 < center_y - eye_height / 2 + 3)
             {
                 iris_center_y = center_y - eye_height / 2 + iris_height / 2 + 3;
+                iris_sub_y = 0;
             }
             if (iris_center_y + iris_height / 2 > center_y + eye_height / 2 - 3)
             {
                 iris_center_y = center_y + eye_height / 2 - iris_height / 2 - 3;
+                iris_sub_y = 0;
             }
 
+            /* Iris, pupil and highlights move together by the pupil's
+             * fractional offset (SDF backend only) */
+            face_state.sdf_target.sub_x += iris_sub_x;
+            face_state.sdf_target.sub_y += iris_sub_y;
+
             rect_dsc.bg_color = lv_color_make(50, 180, 255);
             rect_dsc.border_width = 2;
             rect_dsc.border_color = lv_color_make(30, 140, 230);
@@ -506,7 +2599,7 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
             iris_area.x2 = iris_center_x + iris_width / 2;
             iris_area.y2 = iris_center_y + iris_height / 2;
 
-            lv_draw_rect(&layer, &rect_dsc, &iris_area);
+            face_draw_rect(&layer, &rect_dsc, &iris_area);
 
             int16_t pupil_width = iris_width * 0.5;
             int16_t pupil_height = iris_height * 0.6;
@@ -520,7 +2613,7 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
             pupil_area.x2 = iris_center_x + pupil_width / 2;
             pupil_area.y2 = iris_center_y + pupil_height / 2;
 
-            lv_draw_rect(&layer, &rect_dsc, &pupil_area);
+            face_draw_rect(&layer, &rect_dsc, &pupil_area);
 
             int16_t highlight_w = pupil_width * 0.4;
             int16_t highlight_h = pupil_height * 0.4;
@@ -538,7 +2631,7 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
             highlight_area.x2 = iris_center_x - pupil_width / 3 + highlight_w / 2;
             highlight_area.y2 = iris_center_y - pupil_height / 3 + highlight_h / 2;
 
-            lv_draw_rect(&layer, &rect_dsc, &highlight_area);
+            face_draw_rect(&layer, &rect_dsc, &highlight_area);
 
             int16_t small_w = highlight_w / 2;
             int16_t small_h = highlight_h / 2;
@@ -554,10 +2647,13 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
             highlight_area.x2 = iris_center_x + pupil_width / 4 + small_w / 2;
             highlight_area.y2 = iris_center_y - pupil_height / 4 + small_h / 2;
 
-            lv_draw_rect(&layer, &rect_dsc, &highlight_area);
+            face_draw_rect(&layer, &rect_dsc, &highlight_area);
+
+            face_state.sdf_target.sub_x -= iris_sub_x;
+            face_state.sdf_target.sub_y -= iris_sub_y;
         }
 
-        if (face_state.sparkle_phase > 0)
+        if (face_state.sparkle_phase > 0 && openness > 20)
         {
             rect_dsc.bg_color = lv_color_make(255, 255, 100);
             rect_dsc.bg_opa = (face_state.sparkle_phase * LV_OPA_COVER) / 100;
@@ -566,9 +2662,10 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
 
             for (int i = 0; i < 3; i++)
             {
-                float angle = (i * 120 + face_state.sparkle_phase * 3.6) * 3.14159 / 180.0;
-                int16_t spark_x = center_x + (eye_width / 2 + 8) * cos(angle);
-                int16_t spark_y = center_y + (eye_width / 2 + 8) * sin(angle);
+                /* A third of a turn apart, 3.6 degrees per phase step */
+                uint16_t angle = (uint16_t)(i * 0x10000 / 3 + face_state.sparkle_phase * 0x10000 / 100);
+                int16_t spark_x = center_x + (eye_width / 2 + 8) * face_cos_q15(angle) / 32768;
+                int16_t spark_y = center_y + (eye_width / 2 + 8) * face_sin_q15(angle) / 32768;
 
                 lv_area_t spark_area;
                 spark_area.x1 = spark_x - 2;
@@ -576,9 +2673,12 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
                 spark_area.x2 = spark_x + 2;
                 spark_area.y2 = spark_y + 2;
 
-                lv_draw_rect(&layer, &rect_dsc, &spark_area);
+                face_draw_rect(&layer, &rect_dsc, &spark_area);
             }
         }
+
+        if (openness <= 20)
+            draw_lashes(&layer, center_x, eye_area.y1 + 1, eye_width, is_left);
     }
     else
     {
@@ -593,132 +2693,154 @@ static void draw_eye(lv_obj_t *canvas, uint8_t openness, bool is_left)
         line_dsc.p1.y = center_y;
         line_dsc.p2.x = center_x + eye_width / 2;
         line_dsc.p2.y = center_y;
-        lv_draw_line(&layer, &line_dsc);
+        face_draw_line(&layer, &line_dsc);
 
-        line_dsc.width = 2;
-        for (int i = 0; i < 4; i++)
-        {
-            int16_t x = center_x - eye_width / 3 + (eye_width * i / 4);
-            int16_t lash_length = 6;
+        draw_lashes(&layer, center_x, center_y, eye_width, is_left);
+    }
 
-            line_dsc.p1.x = x;
-            line_dsc.p1.y = center_y;
-            line_dsc.p2.x = x + (is_left ? -2 : 2);
-            line_dsc.p2.y = center_y - lash_length;
-            lv_draw_line(&layer, &line_dsc);
-        }
+    draw_particles(&layer, is_left ? FACE_PART_LEFT_EYE : FACE_PART_RIGHT_EYE);
+
+    if (canvas)
+        lv_canvas_finish_layer(canvas, &layer);
+}
+
+static uint16_t mesh_weight(int32_t num, int32_t den)
+{
+    return (uint16_t)LV_CLAMP(0, num * FACE_MESH_ONE / den, FACE_MESH_ONE);
+}
+
+/*
+ * Mesh counterpart of the threshold-picked mouth shapes: `curve` maps to
+ * overlapping blend weights, so a smile opens, rounds into an "o" around
+ * 50 and turns into a frown without a visible switch.
+ */
+/* SURPRISED's diamond mouth, `stretch` px longer than a plain diamond */
+static void draw_mouth_diamond(int32_t cx, int32_t cy, int16_t stretch)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_color_make(200, 70, 90);
+    rect_dsc.bg_opa = LV_OPA_90;
+    rect_dsc.border_color = lv_color_black();
+    rect_dsc.border_width = 3;
+    rect_dsc.border_opa = LV_OPA_COVER;
+    rect_dsc.radius = 4;
+    face_draw_diamond(cx, cy, stretch + 6, &rect_dsc);
+}
+
+/* Four sparkles around the small open mouth */
+static void draw_mouth_sparkles(lv_layer_t *layer, int32_t cx, int32_t cy, int16_t radius)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_color = lv_color_make(255, 255, 150);
+    rect_dsc.bg_opa = LV_OPA_70;
+    rect_dsc.border_width = 0;
+    rect_dsc.radius = 2;
+
+    for (int i = 0; i < 4; i++)
+    {
+        uint16_t angle = (uint16_t)(i * 0x4000);
+        int16_t spark_x = cx + radius * face_cos_q15(angle) / 32768;
+        int16_t spark_y = cy + radius * face_sin_q15(angle) / 32768;
+
+        lv_area_t spark_area;
+        spark_area.x1 = spark_x - 2;
+        spark_area.y1 = spark_y - 2;
+        spark_area.x2 = spark_x + 2;
+        spark_area.y2 = spark_y + 2;
+        face_draw_rect(layer, &rect_dsc, &spark_area);
+    }
+}
+
+/* Returns the y the mouth outline is centred on */
+static int32_t draw_mouth_mesh(lv_layer_t *layer, int8_t curve)
+{
+    uint16_t width = FACE_MOUTH_CW;
+    uint16_t height = FACE_MOUTH_CH;
+    int16_t mouth_width = width * 0.85;
+    uint16_t w[FACE_MOUTH_SHAPE_COUNT] = {0};
+
+    if (face_state.current_emotion == FACE_WORKING_HARD)
+    {
+        w[FACE_MOUTH_GRIT] = FACE_MESH_ONE;
+    }
+    else
+    {
+        uint16_t o = mesh_weight(15 - LV_ABS(curve - 50), 15);
+        w[FACE_MOUTH_O] = o;
+        w[FACE_MOUTH_SMILE] = (uint16_t)(mesh_weight(curve, 70) * (FACE_MESH_ONE - o) / FACE_MESH_ONE);
+        w[FACE_MOUTH_FROWN] = mesh_weight(-curve, 60);
+        w[FACE_MOUTH_OPEN] = mesh_weight(curve - 90, 30) + mesh_weight(-curve - 35, 120);
     }
 
-    bool show_sweat = (face_state.current_emotion == FACE_WORKING_HARD) ||
-                      (face_state.current_emotion == FACE_SLEEPY && is_left);
-    if (show_sweat)
+    const face_mesh_t *mesh = face_mesh_mouth();
+    int32_t cx = width * 8;
+    int32_t cy = (height / 2 + face_state.bounce_offset) * 16 + 8;
+    int32_t hw = mouth_width * 8;
+    int32_t hh = height * 16 * 4 / 10;
+
+    /* Fit the evaluated outline inside the canvas margins */
+    int32_t xs[FACE_MESH_MAX_VERTS], ys[FACE_MESH_MAX_VERTS];
+    face_mesh_eval(mesh, w, cx, cy, hw, hh, xs, ys);
+    int32_t top = INT32_MAX, bottom = INT32_MIN;
+    for (uint32_t i = 0; i < mesh->verts; i++)
     {
-        bool is_working = (face_state.current_emotion == FACE_WORKING_HARD);
-
-        lv_draw_rect_dsc_t sweat_dsc;
-        lv_draw_rect_dsc_init(&sweat_dsc);
-
-        uint8_t drop_offset;
-        if (is_working)
-        {
-            drop_offset = is_left ? face_state.sweat_drop_offset
-                                  : (uint8_t)((face_state.sweat_drop_offset + 50) % 100);
-        }
-        else
-        {
-            drop_offset = face_state.sweat_drop_offset;
-        }
-
-        int16_t drop_x = is_left ? (center_x - eye_width / 2 + 2)
-                                 : (center_x + eye_width / 2 - 2);
-        int16_t drop_start_y = eyebrow_y - 8;
-        if (drop_start_y < 2)
-            drop_start_y = 2;
-        int16_t drop_range = (int16_t)height - 6 - drop_start_y;
-        if (drop_range < 10)
-            drop_range = 10;
-        int16_t drop_y = drop_start_y + (drop_offset * drop_range) / 100;
-
-        int16_t drop_w = is_working ? 4 : 3;
-        int16_t drop_top = is_working ? 10 : 7;
-        int16_t drop_bot = is_working ? 4 : 3;
-
-        sweat_dsc.bg_color = lv_color_make(120, 200, 255);
-        sweat_dsc.bg_opa = is_working ? LV_OPA_90 : LV_OPA_70;
-        sweat_dsc.border_color = lv_color_make(80, 150, 240);
-        sweat_dsc.border_width = 1;
-        sweat_dsc.border_opa = LV_OPA_60;
-        sweat_dsc.radius = 6;
-
-        lv_area_t drop_area;
-        drop_area.x1 = drop_x - drop_w;
-        drop_area.y1 = drop_y - drop_top;
-        drop_area.x2 = drop_x + drop_w;
-        drop_area.y2 = drop_y + drop_bot;
-        lv_draw_rect(&layer, &sweat_dsc, &drop_area);
-
-        sweat_dsc.bg_color = lv_color_white();
-        sweat_dsc.bg_opa = LV_OPA_80;
-        sweat_dsc.border_width = 0;
-        sweat_dsc.radius = 3;
-
-        lv_area_t shine_area;
-        int16_t shine_w = is_working ? 2 : 1;
-        shine_area.x1 = drop_x - shine_w;
-        shine_area.y1 = drop_y - drop_top + 2;
-        shine_area.x2 = drop_x;
-        shine_area.y2 = drop_y - drop_top + (is_working ? 5 : 4);
-        lv_draw_rect(&layer, &sweat_dsc, &shine_area);
-    }
-
-    if (face_state.current_emotion == FACE_CRY && openness > 30)
-    {
-        lv_draw_rect_dsc_t rect_dsc;
-        lv_draw_rect_dsc_init(&rect_dsc);
-
-        rect_dsc.bg_color = lv_color_make(150, 200, 255);
-        rect_dsc.bg_opa = LV_OPA_80;
-        rect_dsc.border_width = 0;
-        rect_dsc.radius = 5;
-
-        int16_t tear_x = center_x + (is_left ? -eye_width / 3 : eye_width / 3);
-        int16_t tear_y = center_y + eye_height / 2 + 5 + face_state.tear_fall_offset;
+        top = LV_MIN(top, ys[i]);
+        bottom = LV_MAX(bottom, ys[i]);
+    }
+    int32_t margin = 5 * 16;
+    int32_t shift = 0;
+    if (bottom > height * 16 - margin)
+        shift = height * 16 - margin - bottom;
+    if (top + shift < margin)
+        shift = margin - top;
 
-        lv_area_t tear_area;
-        tear_area.x1 = tear_x - 3;
-        tear_area.y1 = tear_y - 5;
-        tear_area.x2 = tear_x + 3;
-        tear_area.y2 = tear_y + 5;
-        lv_draw_rect(&layer, &rect_dsc, &tear_area);
+    lv_area_t bounds;
+    face_draw_mesh(mesh, w, cx, cy + shift, hw, hh, lv_color_make(200, 60, 80), LV_OPA_90, 3, &bounds);
 
-        line_dsc.color = lv_color_make(150, 200, 255);
-        line_dsc.width = 2;
-        line_dsc.opa = LV_OPA_40;
-        line_dsc.round_start = 1;
-        line_dsc.round_end = 1;
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
 
-        line_dsc.p1.x = tear_x;
-        line_dsc.p1.y = center_y + eye_height / 2 + 2;
-        line_dsc.p2.x = tear_x + (is_left ? -1 : 1);
-        line_dsc.p2.y = tear_y - 5;
-        lv_draw_line(&layer, &line_dsc);
+    if (w[FACE_MOUTH_GRIT])
+    {
+        rect_dsc.bg_color = lv_color_make(245, 245, 240);
+        rect_dsc.bg_opa = LV_OPA_90;
+        rect_dsc.radius = 3;
+        lv_area_t teeth = {bounds.x1 + 6, bounds.y1 + 4, bounds.x2 - 6, bounds.y2 - 4};
+        face_draw_rect(layer, &rect_dsc, &teeth);
     }
-
-    lv_canvas_finish_layer(canvas, &layer);
+    else if (curve > 100)
+    {
+        int32_t lip = ys[FACE_MESH_MOUTH_LOWER_MID] + shift;
+        int16_t tongue_w = mouth_width / 5;
+        int16_t tongue_h = (bounds.y2 - bounds.y1) / 3;
+        rect_dsc.bg_color = lv_color_make(255, 140, 160);
+        rect_dsc.bg_opa = LV_OPA_90;
+        rect_dsc.border_color = lv_color_make(200, 80, 100);
+        rect_dsc.border_width = 2;
+        rect_dsc.radius = 8;
+        lv_area_t tongue = {width / 2 - tongue_w / 2, (lip >> 4) - 2 - tongue_h,
+                            width / 2 + tongue_w / 2, (lip >> 4) - 2};
+        face_draw_rect(layer, &rect_dsc, &tongue);
+    }
+    return (cy + shift) >> 4;
 }
 
 static void draw_mouth(lv_obj_t *canvas, int8_t curve)
 {
-    if (!canvas)
+    /* Without a canvas the SDF backend still draws into sdf_target */
+    if (!canvas && !backend_is_sdf())
         return;
 
-    uint16_t width = face_state.mouth_cw;
-    uint16_t height = face_state.mouth_ch;
+    uint16_t width = FACE_MOUTH_CW;
+    uint16_t height = FACE_MOUTH_CH;
 
-    lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
+    canvas_clear(canvas);
 
     lv_layer_t layer;
-    lv_canvas_init_layer(canvas, &layer);
+    if (canvas)
+        lv_canvas_init_layer(canvas, &layer);
 
     int16_t center_x = width / 2;
     int16_t mouth_width = width * 0.85;
@@ -784,7 +2906,22 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
     lv_draw_line_dsc_t line_dsc;
     lv_draw_line_dsc_init(&line_dsc);
 
-    if (face_state.current_emotion == FACE_WORKING_HARD)
+    if (backend_is_mesh())
+    {
+        int32_t mesh_y = draw_mouth_mesh(&layer, curve);
+
+        /* The diamond and sparkles have no blend shape; they go over the
+         * small open mouth the mesh morphs to */
+        if (face_state.current_emotion != FACE_WORKING_HARD && curve > 35 && curve < 65)
+        {
+            int16_t radius = mouth_width / 3;
+            mesh_y = LV_CLAMP(min_y + radius, mesh_y, max_y - radius);
+            if (face_state.diamond_mouth_phase > 30)
+                draw_mouth_diamond(center_x, mesh_y, 3 + face_state.diamond_mouth_phase * 8 / 100);
+            draw_mouth_sparkles(&layer, center_x, mesh_y, radius);
+        }
+    }
+    else if (face_state.current_emotion == FACE_WORKING_HARD)
     {
         int16_t mouth_h = height * 0.28;
         int16_t grip_width = mouth_width * 0.78;
@@ -807,7 +2944,7 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
         mouth_area.y1 = adjusted_y;
         mouth_area.x2 = center_x + grip_width / 2;
         mouth_area.y2 = adjusted_y + mouth_h;
-        lv_draw_rect(&layer, &rect_dsc, &mouth_area);
+        face_draw_rect(&layer, &rect_dsc, &mouth_area);
 
         int16_t t_margin = 4;
         rect_dsc.bg_color = lv_color_make(245, 245, 240);
@@ -820,7 +2957,7 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
         teeth_area.y1 = adjusted_y + t_margin;
         teeth_area.x2 = mouth_area.x2 - t_margin;
         teeth_area.y2 = adjusted_y + mouth_h - t_margin;
-        lv_draw_rect(&layer, &rect_dsc, &teeth_area);
+        face_draw_rect(&layer, &rect_dsc, &teeth_area);
 
         line_dsc.color = lv_color_make(180, 180, 170);
         line_dsc.width = 1;
@@ -836,7 +2973,7 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
             line_dsc.p1.y = teeth_area.y1;
             line_dsc.p2.x = tooth_x;
             line_dsc.p2.y = teeth_area.y2;
-            lv_draw_line(&layer, &line_dsc);
+            face_draw_line(&layer, &line_dsc);
         }
     }
 
@@ -859,7 +2996,7 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
         mouth_area.x2 = center_x + mouth_width / 2;
         mouth_area.y2 = adjusted_y + mouth_h / 2;
 
-        lv_draw_rect(&layer, &rect_dsc, &mouth_area);
+        face_draw_rect(&layer, &rect_dsc, &mouth_area);
 
         if (curve > 100)
         {
@@ -876,7 +3013,7 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
             tongue_area.y1 = adjusted_y + mouth_h / 5;
             tongue_area.x2 = center_x + tongue_w / 2;
             tongue_area.y2 = adjusted_y + mouth_h / 5 + tongue_h;
-            lv_draw_rect(&layer, &rect_dsc, &tongue_area);
+            face_draw_rect(&layer, &rect_dsc, &tongue_area);
         }
 
         if (curve > 85)
@@ -896,7 +3033,7 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
                 spark_area.y1 = spark_y - 2;
                 spark_area.x2 = spark_x + 2;
                 spark_area.y2 = spark_y + 2;
-                lv_draw_rect(&layer, &rect_dsc, &spark_area);
+                face_draw_rect(&layer, &rect_dsc, &spark_area);
             }
         }
     }
@@ -911,45 +3048,52 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
 
             int16_t stretch = 3 + (diamond_factor * 8);
 
-            rect_dsc.bg_color = lv_color_make(200, 70, 90);
-            rect_dsc.bg_opa = LV_OPA_90;
-            rect_dsc.border_color = lv_color_black();
-            rect_dsc.border_width = 3;
-            rect_dsc.border_opa = LV_OPA_COVER;
-            rect_dsc.radius = 4;
-
-            lv_area_t diamond_area;
-            diamond_area.x1 = center_x - 6;
-            diamond_area.y1 = center_y + curve_offset - stretch - 6;
-            diamond_area.x2 = center_x + 6;
-            diamond_area.y2 = center_y + curve_offset - 2;
-            lv_draw_rect(&layer, &rect_dsc, &diamond_area);
-
-            diamond_area.x1 = center_x + 2;
-            diamond_area.y1 = center_y + curve_offset - 6;
-            diamond_area.x2 = center_x + stretch + 6;
-            diamond_area.y2 = center_y + curve_offset + 6;
-            lv_draw_rect(&layer, &rect_dsc, &diamond_area);
-
-            diamond_area.x1 = center_x - 6;
-            diamond_area.y1 = center_y + curve_offset + 2;
-            diamond_area.x2 = center_x + 6;
-            diamond_area.y2 = center_y + curve_offset + stretch + 6;
-            lv_draw_rect(&layer, &rect_dsc, &diamond_area);
-
-            diamond_area.x1 = center_x - stretch - 6;
-            diamond_area.y1 = center_y + curve_offset - 6;
-            diamond_area.x2 = center_x - 2;
-            diamond_area.y2 = center_y + curve_offset + 6;
-            lv_draw_rect(&layer, &rect_dsc, &diamond_area);
-
-            rect_dsc.border_width = 0;
-            rect_dsc.radius = 2;
-            diamond_area.x1 = center_x - 4;
-            diamond_area.y1 = center_y + curve_offset - 4;
-            diamond_area.x2 = center_x + 4;
-            diamond_area.y2 = center_y + curve_offset + 4;
-            lv_draw_rect(&layer, &rect_dsc, &diamond_area);
+            if (backend_is_sdf())
+            {
+                draw_mouth_diamond(center_x, center_y + curve_offset, stretch);
+            }
+            else
+            {
+                rect_dsc.bg_color = lv_color_make(200, 70, 90);
+                rect_dsc.bg_opa = LV_OPA_90;
+                rect_dsc.border_color = lv_color_black();
+                rect_dsc.border_width = 3;
+                rect_dsc.border_opa = LV_OPA_COVER;
+                rect_dsc.radius = 4;
+
+                lv_area_t diamond_area;
+                diamond_area.x1 = center_x - 6;
+                diamond_area.y1 = center_y + curve_offset - stretch - 6;
+                diamond_area.x2 = center_x + 6;
+                diamond_area.y2 = center_y + curve_offset - 2;
+                face_draw_rect(&layer, &rect_dsc, &diamond_area);
+
+                diamond_area.x1 = center_x + 2;
+                diamond_area.y1 = center_y + curve_offset - 6;
+                diamond_area.x2 = center_x + stretch + 6;
+                diamond_area.y2 = center_y + curve_offset + 6;
+                face_draw_rect(&layer, &rect_dsc, &diamond_area);
+
+                diamond_area.x1 = center_x - 6;
+                diamond_area.y1 = center_y + curve_offset + 2;
+                diamond_area.x2 = center_x + 6;
+                diamond_area.y2 = center_y + curve_offset + stretch + 6;
+                face_draw_rect(&layer, &rect_dsc, &diamond_area);
+
+                diamond_area.x1 = center_x - stretch - 6;
+                diamond_area.y1 = center_y + curve_offset - 6;
+                diamond_area.x2 = center_x - 2;
+                diamond_area.y2 = center_y + curve_offset + 6;
+                face_draw_rect(&layer, &rect_dsc, &diamond_area);
+
+                rect_dsc.border_width = 0;
+                rect_dsc.radius = 2;
+                diamond_area.x1 = center_x - 4;
+                diamond_area.y1 = center_y + curve_offset - 4;
+                diamond_area.x2 = center_x + 4;
+                diamond_area.y2 = center_y + curve_offset + 4;
+                face_draw_rect(&layer, &rect_dsc, &diamond_area);
+            }
         }
         else
         {
@@ -970,27 +3114,10 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
             mouth_area.x2 = center_x + mouth_width_oval;
             mouth_area.y2 = center_y + curve_offset + mouth_height_oval;
 
-            lv_draw_rect(&layer, &rect_dsc, &mouth_area);
+            face_draw_rect(&layer, &rect_dsc, &mouth_area);
         }
 
-        rect_dsc.bg_color = lv_color_make(255, 255, 150);
-        rect_dsc.bg_opa = LV_OPA_70;
-        rect_dsc.border_width = 0;
-        rect_dsc.radius = 2;
-
-        for (int i = 0; i < 4; i++)
-        {
-            float angle = i * 90 * 3.14159 / 180.0;
-            int16_t spark_x = center_x + (mouth_width / 3) * cos(angle);
-            int16_t spark_y = center_y + curve_offset + (mouth_width / 3) * sin(angle);
-
-            lv_area_t spark_area;
-            spark_area.x1 = spark_x - 2;
-            spark_area.y1 = spark_y - 2;
-            spark_area.x2 = spark_x + 2;
-            spark_area.y2 = spark_y + 2;
-            lv_draw_rect(&layer, &rect_dsc, &spark_area);
-        }
+        draw_mouth_sparkles(&layer, center_x, center_y + curve_offset, mouth_width / 3);
     }
 
     else if (curve < -35)
@@ -1011,52 +3138,7 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
         mouth_area.x2 = center_x + mouth_width / 2;
         mouth_area.y2 = adjusted_y + mouth_h;
 
-        lv_draw_rect(&layer, &rect_dsc, &mouth_area);
-
-        if (curve < -50)
-        {
-            rect_dsc.bg_color = lv_color_make(150, 200, 255);
-            rect_dsc.bg_opa = LV_OPA_70;
-            rect_dsc.border_width = 0;
-            rect_dsc.radius = 4;
-
-            int16_t tear_base_y = center_y - 8;
-            int16_t tear_y = tear_base_y + face_state.tear_fall_offset;
-
-            int16_t tear_x_left = center_x - mouth_width / 2 - 10;
-
-            lv_area_t tear_area;
-            tear_area.x1 = tear_x_left - 4;
-            tear_area.y1 = tear_y - 4;
-            tear_area.x2 = tear_x_left + 4;
-            tear_area.y2 = tear_y + 4;
-            lv_draw_rect(&layer, &rect_dsc, &tear_area);
-
-            int16_t tear_x_right = center_x + mouth_width / 2 + 10;
-            tear_area.x1 = tear_x_right - 4;
-            tear_area.y1 = tear_y - 4;
-            tear_area.x2 = tear_x_right + 4;
-            tear_area.y2 = tear_y + 4;
-            lv_draw_rect(&layer, &rect_dsc, &tear_area);
-
-            line_dsc.color = lv_color_make(150, 200, 255);
-            line_dsc.width = 2;
-            line_dsc.opa = LV_OPA_50;
-            line_dsc.round_start = 1;
-            line_dsc.round_end = 1;
-
-            line_dsc.p1.x = tear_x_left;
-            line_dsc.p1.y = tear_base_y;
-            line_dsc.p2.x = tear_x_left - 1;
-            line_dsc.p2.y = tear_y - 4;
-            lv_draw_line(&layer, &line_dsc);
-
-            line_dsc.p1.x = tear_x_right;
-            line_dsc.p1.y = tear_base_y;
-            line_dsc.p2.x = tear_x_right + 1;
-            line_dsc.p2.y = tear_y - 4;
-            lv_draw_line(&layer, &line_dsc);
-        }
+        face_draw_rect(&layer, &rect_dsc, &mouth_area);
     }
 
     else
@@ -1090,10 +3172,13 @@ static void draw_mouth(lv_obj_t *canvas, int8_t curve)
         mouth_area.x2 = center_x + smile_width / 2;
         mouth_area.y2 = center_y + mouth_h;
 
-        lv_draw_rect(&layer, &rect_dsc, &mouth_area);
+        face_draw_rect(&layer, &rect_dsc, &mouth_area);
     }
 
-    lv_canvas_finish_layer(canvas, &layer);
+    draw_particles(&layer, FACE_PART_MOUTH);
+
+    if (canvas)
+        lv_canvas_finish_layer(canvas, &layer);
 }
 
 static void update_emotion_parameters(face_emotion_t emotion, uint8_t *left_eye, uint8_t *right_eye, int8_t *mouth,
@@ -1317,17 +3402,289 @@ static void update_emotion_parameters(face_emotion_t emotion, uint8_t *left_eye,
     }
 }
 
-static void animation_timer_cb(lv_timer_t *timer)
+static void set_bounce(int32_t q8)
 {
-    if (!face_state.initialized)
-        return;
+    face_state.bounce_q8 = (int16_t)q8;
+    face_state.bounce_offset = (int8_t)(q8 / 256);
+}
+
+static void set_pupil_x(int32_t q8)
+{
+    face_state.pupil_x_q8 = (int16_t)q8;
+    face_state.pupil_offset_x = (int8_t)(q8 / 256);
+}
+
+static void set_pupil_y(int32_t q8)
+{
+    face_state.pupil_y_q8 = (int16_t)q8;
+    face_state.pupil_offset_y = (int8_t)(q8 / 256);
+}
+
+static void start_blink(void)
+{
+    face_state.is_blinking = true;
+    face_state.blink_phase = 0;
+}
+
+static uint32_t fx_rand(void)
+{
+    face_state.fx_seed = face_state.fx_seed * 1103515245u + 12345u;
+    return face_state.fx_seed >> 16;
+}
+
+/* Take a free pool slot; when the pool is full the spawn is dropped */
+static face_particle_t *fx_spawn(face_fx_t type, face_part_t part, int32_t x, int32_t y, uint8_t life)
+{
+    for (int i = 0; i < FACE_MAX_PARTICLES; i++)
+    {
+        face_particle_t *pt = &face_state.particles[i];
+        if (pt->type != FACE_FX_NONE)
+            continue;
+
+        memset(pt, 0, sizeof(*pt));
+        pt->type = type;
+        pt->part = part;
+        pt->x = x * 256;
+        pt->y = y * 256;
+        pt->life = life;
+        pt->max_life = life;
+        return pt;
+    }
+    return NULL;
+}
+
+static void fx_clear(void)
+{
+    memset(face_state.particles, 0, sizeof(face_state.particles));
+}
+
+/* Eye outline centre and size as draw_eye() lays it out */
+static void eye_layout(uint8_t openness, int16_t *cx, int16_t *cy, int16_t *ew, int16_t *eh)
+{
+    *ew = FACE_EYE_CW * 0.75;
+    *eh = (*ew * openness) / 100;
+    if (*eh < 8)
+        *eh = 8;
+    *cx = FACE_EYE_CW / 2;
+    *cy = (FACE_EYE_CW * 0.6) + face_state.bounce_offset;
+}
+
+/* Emit this tick's particles for the current emotion; spawn times are
+ * staggered between the two sides so drops never fall in lockstep */
+static void fx_emit(void)
+{
+    face_emotion_t emotion = face_state.current_emotion;
+    uint32_t t = face_state.fx_tick;
+
+    for (int side = 0; side < 2; side++)
+    {
+        face_part_t part = side ? FACE_PART_RIGHT_EYE : FACE_PART_LEFT_EYE;
+        bool is_left = (side == 0);
+        uint8_t openness = is_left ? face_state.left_eye_openness : face_state.right_eye_openness;
+        int16_t cx, cy, ew, eh;
+        eye_layout(openness, &cx, &cy, &ew, &eh);
+
+        if (emotion == FACE_CRY && openness > 30 && (t + side * 9) % 18 == 0)
+        {
+            int32_t x = cx + (is_left ? -ew / 3 : ew / 3) + (int32_t)(fx_rand() % 5) - 2;
+            face_particle_t *pt = fx_spawn(FACE_FX_TEAR, part, x, cy + eh / 2 + 5, 60);
+            if (pt)
+            {
+                pt->size = 6;
+                pt->vy = 192;
+                pt->ay = 14;
+            }
+        }
+
+        /* Sweat runs brow to chin in one cycle: 34 ticks when working hard,
+         * 100 when sleepy (left eye only) */
+        bool working = (emotion == FACE_WORKING_HARD);
+        int32_t period = working ? 34 : 100;
+        if ((working || (emotion == FACE_SLEEPY && is_left)) && (t + side * 17) % period == 0)
+        {
+            int32_t start_y = cy - ew / 2 - 6 + face_state.eyebrow_height - 8;
+            if (start_y < 2)
+                start_y = 2;
+            int32_t range = (int32_t)FACE_EYE_CW - 6 - start_y;
+            if (range < 10)
+                range = 10;
+
+            int32_t x = is_left ? (cx - ew / 2 + 2) : (cx + ew / 2 - 2);
+            face_particle_t *pt = fx_spawn(FACE_FX_SWEAT, part, x, start_y, (uint8_t)period);
+            if (pt)
+            {
+                /* Half the drop comes from the start speed, half from gravity */
+                pt->size = working ? 4 : 3;
+                pt->vy = (int16_t)(range * 256 / (2 * period));
+                pt->ay = (int16_t)(range * 256 / (period * period));
+            }
+        }
+
+        if (emotion == FACE_EXCITED && (t + side * 8) % 16 == 0)
+        {
+            static const int8_t dirs[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+            int32_t x = cx + (int32_t)(fx_rand() % ew) - ew / 2;
+            int32_t y = cy - eh / 2 - (int32_t)(fx_rand() % 6);
+
+            for (int d = 0; d < 4; d++)
+            {
+                face_particle_t *pt = fx_spawn(FACE_FX_SPARKLE, part, x, y, 10);
+                if (!pt)
+                    break;
+                pt->size = 2;
+                pt->vx = dirs[d][0] * 160;
+                pt->vy = dirs[d][1] * 160;
+            }
+        }
+    }
+
+    int32_t mw = FACE_MOUTH_CW;
+    int32_t mh = FACE_MOUTH_CH;
+    int32_t mouth_width = mw * 0.85;
+
+    if ((emotion == FACE_SAD || emotion == FACE_CRY) && face_state.mouth_curve < -50 && t % 12 == 0)
+    {
+        bool left = (t / 12) % 2 == 0;
+        int32_t x = mw / 2 + (left ? -(mouth_width / 2 + 10) : mouth_width / 2 + 10);
+        face_particle_t *pt = fx_spawn(FACE_FX_TEAR, FACE_PART_MOUTH, x, mh / 2 + face_state.bounce_offset - 8, 50);
+        if (pt)
+        {
+            pt->size = 8;
+            pt->vy = 256;
+            pt->ay = 10;
+        }
+    }
+
+    if (emotion == FACE_LOVE && t % 20 == 0)
+    {
+        bool left = (t / 20) % 2 == 0;
+        int32_t x = left ? 4 + (int32_t)(fx_rand() % (mw / 8 + 1)) : mw - 4 - (int32_t)(fx_rand() % (mw / 8 + 1));
+        face_particle_t *pt = fx_spawn(FACE_FX_HEART, FACE_PART_MOUTH, x, mh - 6, 40);
+        if (pt)
+        {
+            pt->size = 6 + (uint8_t)(fx_rand() % 4);
+            pt->vx = (int16_t)(fx_rand() % 64) - 32;
+            pt->vy = -160;
+        }
+    }
+}
+
+/*
+ * Advance the particle pool by one tick with integer physics and emit new
+ * particles.  Returns the FACE_DIRTY_* canvases whose particles changed.
+ */
+static uint8_t fx_update(void)
+{
+    uint8_t dirty = 0;
+
+    face_state.fx_tick++;
+    fx_emit();
+
+    for (int i = 0; i < FACE_MAX_PARTICLES; i++)
+    {
+        face_particle_t *pt = &face_state.particles[i];
+        if (pt->type == FACE_FX_NONE)
+            continue;
+
+        uint16_t w, h;
+        part_size((face_part_t)pt->part, &w, &h);
+
+        pt->vy += pt->ay;
+        pt->x += pt->vx;
+        pt->y += pt->vy;
+        if (--pt->life == 0 || (pt->y >> 8) - pt->size > h || (pt->y >> 8) + 12 < 0)
+            pt->type = FACE_FX_NONE;
+
+        dirty |= 1u << pt->part;
+    }
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        if (dirty & (1u << p))
+            face_state.fx_version[p]++;
+    }
+    return dirty;
+}
+
+/* `n` reference ticks in ms */
+#define ANIM_TICKS(n) ((n) * FACE_TICK_MS)
+
+/* Phase increment per ms, in Q32 turns, of a curve that advances `k` rad
+ * per reference tick; folds to an integer constant */
+#define ANIM_RATE(k) ((uint32_t)((k) / (6.283185307 * FACE_TICK_MS) * 4294967296.0 + 0.5))
+
+/* Q8 px */
+#define Q8(v) ((int32_t)((v) * 256))
+
+/* Phase of a curve at clock `ms`.  The Q32 product wraps once per turn, so
+ * only the low 32 bits of the clock matter and it stays exact however long
+ * the clock has run. */
+static inline uint16_t anim_phase(uint64_t ms, uint32_t rate)
+{
+    return (uint16_t)(((uint32_t)ms * rate) >> 16);
+}
+
+/* amp * sin (cos) of a curve at clock `ms`, truncated toward zero like the
+ * integer fields it feeds */
+static inline int32_t anim_sin(uint64_t ms, uint32_t rate, int32_t amp)
+{
+    return amp * face_sin_q15(anim_phase(ms, rate)) / 32768;
+}
+
+static inline int32_t anim_cos(uint64_t ms, uint32_t rate, int32_t amp)
+{
+    return amp * face_cos_q15(anim_phase(ms, rate)) / 32768;
+}
+
+/* amp * |sin| of a curve at clock `ms` */
+static inline int32_t anim_abs_sin(uint64_t ms, uint32_t rate, int32_t amp)
+{
+    int32_t v = face_sin_q15(anim_phase(ms, rate));
+    return amp * LV_ABS(v) / 32768;
+}
+
+/* Whether the clock passed a multiple of `period` ticks during the last
+ * step; the time-based form of a `counter % period == 0` redraw throttle */
+static bool anim_crossed(uint64_t prev_ms, uint64_t ms, uint32_t period)
+{
+    uint32_t p = period * FACE_TICK_MS;
+    return prev_ms / p != ms / p;
+}
+
+/*
+ * Whole units that a rate of `per_tick` units per tick covered during the
+ * last step.  The clock's sub-tick position carries the remainder from
+ * step to step, so short steps lose nothing and any update rate adds up
+ * to the same pace; the count is bounded by the step's clamped duration.
+ */
+static uint32_t anim_advance(uint32_t per_tick)
+{
+    uint32_t dt = (uint32_t)(face_state.anim_ms - face_state.anim_prev_ms);
+    uint32_t carry = (uint32_t)(face_state.anim_prev_ms % FACE_TICK_MS) * per_tick % FACE_TICK_MS;
+    return (dt * per_tick + carry) / FACE_TICK_MS;
+}
 
-    uint32_t current_time = lv_tick_get();
-    bool needs_redraw = false;
+/*
+ * Advance the animation to time `now` and return the FACE_DIRTY_* canvases
+ * the new state changes.  Every phase moves by the time elapsed since the
+ * previous step, so the pace does not depend on how often this runs.
+ * Reads and writes face_state only, so the lookahead can run it on a copy
+ * to predict the frames that follow.
+ */
+static uint8_t face_step(uint32_t current_time)
+{
+    uint8_t dirty = 0;
+    uint32_t dt = current_time - face_state.step_time;
+    if (dt > FACE_MAX_STEP_MS)
+        dt = FACE_MAX_STEP_MS;
+    face_state.step_time = current_time;
+    face_state.anim_prev_ms = face_state.anim_ms;
+    face_state.anim_ms += dt;
 
     if (face_state.is_blinking)
     {
-        face_state.blink_phase += 20;
+        uint32_t phase = face_state.blink_phase + anim_advance(20);
+        face_state.blink_phase = (uint8_t)LV_MIN(phase, 100);
         if (face_state.blink_phase >= 100)
         {
             face_state.blink_phase = 0;
@@ -1347,19 +3704,20 @@ static void animation_timer_cb(lv_timer_t *timer)
 
         face_state.left_eye_openness = blink_openness;
         face_state.right_eye_openness = blink_openness;
-        needs_redraw = true;
+        dirty |= FACE_DIRTY_EYES;
     }
 
     else if (face_state.config.auto_blink &&
              (current_time - face_state.last_blink_time) > face_state.config.blink_interval)
     {
-        face_trigger_blink();
+        start_blink();
     }
 
     else if (face_state.current_emotion != face_state.target_emotion &&
              face_state.transition_progress < 100)
     {
-        face_state.transition_progress += 10;
+        uint32_t progress = face_state.transition_progress + anim_advance(10);
+        face_state.transition_progress = (uint8_t)LV_MIN(progress, 100);
 
         if (face_state.transition_progress >= 100)
         {
@@ -1390,131 +3748,134 @@ static void animation_timer_cb(lv_timer_t *timer)
         face_state.eyebrow_height = current_brow_height +
                                     ((target_brow_height - current_brow_height) * face_state.transition_progress) / 100;
 
-        needs_redraw = true;
+        dirty |= FACE_DIRTY_ALL;
     }
 
-    static uint32_t bounce_counter = 0;
-    static uint32_t pupil_counter = 0;
-    bounce_counter++;
-    pupil_counter++;
+    /* Curves below run on the animation clock */
+    uint64_t ms = face_state.anim_ms;
+    uint64_t tick = ms / FACE_TICK_MS;
 
     switch (face_state.current_emotion)
     {
     case FACE_HAPPY:
 
     {
-        float ha = (pupil_counter % 80) * 0.1572f;
-        face_state.pupil_offset_x = (int8_t)(7.0f * cosf(ha));
-        face_state.pupil_offset_y = (int8_t)(4.0f * sinf(ha));
-        if (pupil_counter % 2 == 0)
-            needs_redraw = true;
+        uint32_t hms = ms % ANIM_TICKS(80);
+        set_pupil_x(anim_cos(hms, ANIM_RATE(0.1572), Q8(7)));
+        set_pupil_y(anim_sin(hms, ANIM_RATE(0.1572), Q8(4)));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_EYES;
     }
     break;
 
     case FACE_WORRIED:
 
-        face_state.pupil_offset_x = (int8_t)(5.0f * sinf(pupil_counter * 0.06f));
-        face_state.pupil_offset_y = (int8_t)(1.0f * sinf(pupil_counter * 0.09f));
-        if (pupil_counter % 4 == 0)
-            needs_redraw = true;
+        set_pupil_x(anim_sin(ms, ANIM_RATE(0.06), Q8(5)));
+        set_pupil_y(anim_sin(ms, ANIM_RATE(0.09), Q8(1)));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 4))
+            dirty |= FACE_DIRTY_EYES;
         break;
 
     case FACE_PLAYFUL:
     case FACE_LOVE:
 
-        if (pupil_counter % 100 < 50)
+        if (tick % 100 < 50)
         {
-            float angle = (pupil_counter % 100) * 0.125;
-            face_state.pupil_offset_x = 6 * cos(angle);
-            face_state.pupil_offset_y = 4 * sin(angle);
-            if (pupil_counter % 2 == 0)
-                needs_redraw = true;
+            uint32_t pms = ms % ANIM_TICKS(100);
+            set_pupil_x(anim_cos(pms, ANIM_RATE(0.125), Q8(6)));
+            set_pupil_y(anim_sin(pms, ANIM_RATE(0.125), Q8(4)));
+            if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+                dirty |= FACE_DIRTY_EYES;
         }
         else
         {
 
-            face_state.pupil_offset_x = face_state.pupil_offset_x * 0.8;
-            face_state.pupil_offset_y = face_state.pupil_offset_y * 0.8;
-            if (pupil_counter % 3 == 0)
-                needs_redraw = true;
+            /* Settle by a fifth per elapsed tick */
+            for (uint32_t n = anim_advance(1); n > 0; n--)
+            {
+                set_pupil_x(face_state.pupil_x_q8 * 4 / 5);
+                set_pupil_y(face_state.pupil_y_q8 * 4 / 5);
+            }
+            if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 3))
+                dirty |= FACE_DIRTY_EYES;
         }
         break;
 
     case FACE_SURPRISED:
 
-        face_state.pupil_offset_x = 0;
-        face_state.pupil_offset_y = -8;
+        set_pupil_x(0);
+        set_pupil_y(Q8(-8));
         break;
 
     case FACE_SLEEPY:
 
-        face_state.pupil_offset_x = 0;
-        face_state.pupil_offset_y = 5;
+        set_pupil_x(0);
+        set_pupil_y(Q8(5));
         break;
 
     case FACE_SILLY:
 
-        face_state.pupil_offset_x = ((pupil_counter / 5) % 2) ? 10 : -10;
-        face_state.pupil_offset_y = 0;
-        if (pupil_counter % 5 == 0)
-            needs_redraw = true;
+        set_pupil_x(((tick / 5) % 2) ? Q8(10) : Q8(-10));
+        set_pupil_y(0);
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 5))
+            dirty |= FACE_DIRTY_EYES;
         break;
 
     case FACE_WINK:
     case FACE_SMIRK:
 
-        face_state.pupil_offset_x = 5;
-        face_state.pupil_offset_y = 0;
+        set_pupil_x(Q8(5));
+        set_pupil_y(0);
         break;
 
     case FACE_WORKING_HARD:
 
-        face_state.pupil_offset_x = 0;
-        face_state.pupil_offset_y = 4;
+        set_pupil_x(0);
+        set_pupil_y(Q8(4));
         break;
 
     case FACE_EXCITED:
 
-        face_state.pupil_offset_x = (int8_t)(((pupil_counter / 3) % 2) ? 9 : -9);
-        face_state.pupil_offset_y = (int8_t)(((pupil_counter / 5) % 2) ? 7 : -7);
-        if (pupil_counter % 3 == 0)
-            needs_redraw = true;
+        set_pupil_x(((tick / 3) % 2) ? Q8(9) : Q8(-9));
+        set_pupil_y(((tick / 5) % 2) ? Q8(7) : Q8(-7));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 3))
+            dirty |= FACE_DIRTY_EYES;
         break;
 
     case FACE_CONFUSED:
 
-        face_state.pupil_offset_x = (int8_t)(7.0f * cosf(pupil_counter * 0.03f));
-        face_state.pupil_offset_y = (int8_t)(5.0f * sinf(pupil_counter * 0.05f));
-        if (pupil_counter % 2 == 0)
-            needs_redraw = true;
+        set_pupil_x(anim_cos(ms, ANIM_RATE(0.03), Q8(7)));
+        set_pupil_y(anim_sin(ms, ANIM_RATE(0.05), Q8(5)));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_EYES;
         break;
 
     case FACE_COOL:
     {
 
-        uint32_t cp = pupil_counter % 240;
-        if (cp < 60)
+        int32_t cp = (int32_t)(ms % ANIM_TICKS(240));
+        if (cp < ANIM_TICKS(60))
         {
-            face_state.pupil_offset_x = (int8_t)(8.0f * (cp / 60.0f));
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(Q8(8) * cp / ANIM_TICKS(60));
+            set_pupil_y(0);
         }
-        else if (cp < 120)
+        else if (cp < ANIM_TICKS(120))
         {
-            face_state.pupil_offset_x = 8;
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(Q8(8));
+            set_pupil_y(0);
         }
-        else if (cp < 180)
+        else if (cp < ANIM_TICKS(180))
         {
-            face_state.pupil_offset_x = (int8_t)(8.0f * (1.0f - (cp - 120) / 60.0f));
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(Q8(8) * (ANIM_TICKS(180) - cp) / ANIM_TICKS(60));
+            set_pupil_y(0);
         }
         else
         {
-            face_state.pupil_offset_x = 0;
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(0);
+            set_pupil_y(0);
         }
-        if (pupil_counter % 3 == 0)
-            needs_redraw = true;
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 3))
+            dirty |= FACE_DIRTY_EYES;
         break;
     }
 
@@ -1524,60 +3885,31 @@ static void animation_timer_cb(lv_timer_t *timer)
     case FACE_ANGRY:
     default:
 
-        face_state.pupil_offset_x = 0;
-        face_state.pupil_offset_y = 0;
+        set_pupil_x(0);
+        set_pupil_y(0);
         break;
     }
 
-    if (face_state.current_emotion == FACE_SAD || face_state.current_emotion == FACE_CRY)
-    {
-        face_state.tear_fall_offset += 2;
-        if (face_state.tear_fall_offset > 80)
-        {
-            face_state.tear_fall_offset = 0;
-        }
-        needs_redraw = true;
-    }
-    else
-    {
-        face_state.tear_fall_offset = 0;
-    }
-
-    if (face_state.current_emotion == FACE_WORKING_HARD)
-    {
-        face_state.sweat_drop_offset += 3;
-        if (face_state.sweat_drop_offset > 100)
-            face_state.sweat_drop_offset = 0;
-        needs_redraw = true;
-    }
-    else if (face_state.current_emotion == FACE_SLEEPY)
-    {
-        face_state.sweat_drop_offset += 1;
-        if (face_state.sweat_drop_offset > 100)
-            face_state.sweat_drop_offset = 0;
-        needs_redraw = true;
-    }
-    else
-    {
-        face_state.sweat_drop_offset = 0;
-    }
+    /* Particles keep their integer per-tick physics, run once per tick */
+    for (uint32_t n = anim_advance(1); n > 0; n--)
+        dirty |= fx_update();
 
     if (face_state.current_emotion == FACE_SURPRISED)
     {
-
-        static int8_t diamond_direction = 1;
-        face_state.diamond_mouth_phase += diamond_direction * 8;
+        int32_t phase = face_state.diamond_mouth_phase +
+                        face_state.diamond_direction * (int32_t)anim_advance(8);
+        face_state.diamond_mouth_phase = (uint8_t)LV_CLAMP(50, phase, 100);
         if (face_state.diamond_mouth_phase >= 100)
         {
             face_state.diamond_mouth_phase = 100;
-            diamond_direction = -1;
+            face_state.diamond_direction = -1;
         }
         else if (face_state.diamond_mouth_phase <= 50)
         {
             face_state.diamond_mouth_phase = 50;
-            diamond_direction = 1;
+            face_state.diamond_direction = 1;
         }
-        needs_redraw = true;
+        dirty |= FACE_DIRTY_MOUTH;
     }
     else
     {
@@ -1591,308 +3923,306 @@ static void animation_timer_cb(lv_timer_t *timer)
 
     case FACE_HAPPY:
 
-        face_state.bounce_offset = (int8_t)(3.5f * sinf(bounce_counter * 0.28f));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.28), Q8(3.5)));
 
         if (transition_done && !face_state.is_blinking)
         {
-            face_state.left_eye_openness = (uint8_t)(87 + (uint8_t)(13 * fabsf(sinf(bounce_counter * 0.28f))));
+            face_state.left_eye_openness = (uint8_t)(87 + anim_abs_sin(ms, ANIM_RATE(0.28), 13));
             face_state.right_eye_openness = face_state.left_eye_openness;
         }
 
-        face_state.sparkle_phase = (uint8_t)(65 + (uint8_t)(35 * fabsf(sinf(bounce_counter * 0.20f))));
-        face_state.blush_intensity = (uint8_t)(72 + (uint8_t)(18 * fabsf(sinf(bounce_counter * 0.13f))));
+        face_state.sparkle_phase = (uint8_t)(65 + anim_abs_sin(ms, ANIM_RATE(0.20), 35));
+        face_state.blush_intensity = (uint8_t)(72 + anim_abs_sin(ms, ANIM_RATE(0.13), 18));
 
         if (transition_done)
         {
-            face_state.mouth_curve = (int8_t)(87 + (int8_t)(8 * fabsf(sinf(bounce_counter * 0.28f))));
+            face_state.mouth_curve = (int8_t)(87 + anim_abs_sin(ms, ANIM_RATE(0.28), 8));
         }
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_WORRIED:
 
-        face_state.bounce_offset = (int8_t)(1.2f * sinf(bounce_counter * 0.10f) + 0.8f * sinf(bounce_counter * 0.23f));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.10), Q8(1.2)) + anim_sin(ms, ANIM_RATE(0.23), Q8(0.8)));
 
         if (transition_done)
         {
-            face_state.left_eyebrow_angle = (int8_t)(16 + (int8_t)(7 * fabsf(sinf(bounce_counter * 0.17f))));
+            face_state.left_eyebrow_angle = (int8_t)(16 + anim_abs_sin(ms, ANIM_RATE(0.17), 7));
             face_state.right_eyebrow_angle = face_state.left_eyebrow_angle;
-            face_state.eyebrow_height = (int8_t)(-6 - (int8_t)(4 * fabsf(sinf(bounce_counter * 0.17f))));
+            face_state.eyebrow_height = (int8_t)(-6 - anim_abs_sin(ms, ANIM_RATE(0.17), 4));
 
-            face_state.mouth_curve = (int8_t)(22 + (int8_t)(12 * fabsf(sinf(bounce_counter * 0.13f))));
+            face_state.mouth_curve = (int8_t)(22 + anim_abs_sin(ms, ANIM_RATE(0.13), 12));
         }
-        if (bounce_counter % 3 == 0)
-            needs_redraw = true;
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 3))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_LOVE:
 
-        face_state.bounce_offset = (int8_t)(2.0 * sin(bounce_counter * 0.12));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.12), Q8(2)));
 
         if (transition_done && !face_state.is_blinking)
         {
-            face_state.left_eye_openness = (uint8_t)(88 + 12 * fabs(sin(bounce_counter * 0.15)));
+            face_state.left_eye_openness = (uint8_t)(88 + anim_abs_sin(ms, ANIM_RATE(0.15), 12));
             face_state.right_eye_openness = face_state.left_eye_openness;
         }
 
-        face_state.sparkle_phase = (uint8_t)(72 + 28 * fabs(sin(bounce_counter * 0.25)));
-        face_state.heart_beat_phase = (uint8_t)(65 + 35 * fabs(sin(bounce_counter * 0.20)));
-        face_state.blush_intensity = (uint8_t)(80 + 15 * fabs(sin(bounce_counter * 0.15)));
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        face_state.sparkle_phase = (uint8_t)(72 + anim_abs_sin(ms, ANIM_RATE(0.25), 28));
+        face_state.heart_beat_phase = (uint8_t)(65 + anim_abs_sin(ms, ANIM_RATE(0.20), 35));
+        face_state.blush_intensity = (uint8_t)(80 + anim_abs_sin(ms, ANIM_RATE(0.15), 15));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_ANGRY:
 
-        face_state.blush_intensity = (uint8_t)(40 + 28 * fabs(sin(bounce_counter * 0.3)));
+        face_state.blush_intensity = (uint8_t)(40 + anim_abs_sin(ms, ANIM_RATE(0.3), 28));
         if (transition_done)
         {
 
-            face_state.mouth_curve = (int8_t)(-42 + (int8_t)(8 * sin(bounce_counter * 0.5)));
+            face_state.mouth_curve = (int8_t)(-42 + anim_sin(ms, ANIM_RATE(0.5), 8));
 
-            face_state.left_eyebrow_angle = (int8_t)(22 + (int8_t)(5 * sin(bounce_counter * 0.4)));
-            face_state.right_eyebrow_angle = (int8_t)(-22 - (int8_t)(5 * sin(bounce_counter * 0.4)));
+            face_state.left_eyebrow_angle = (int8_t)(22 + anim_sin(ms, ANIM_RATE(0.4), 5));
+            face_state.right_eyebrow_angle = (int8_t)(-22 - anim_sin(ms, ANIM_RATE(0.4), 5));
         }
 
-        face_state.bounce_offset = (bounce_counter % 8 < 2) ? 1 : 0;
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        set_bounce((tick % 8 < 2) ? Q8(1) : 0);
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_SLEEPY:
 
-        face_state.bounce_offset = (int8_t)(3.0 * sin(bounce_counter * 0.04));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.04), Q8(3)));
 
         if (transition_done && !face_state.is_blinking)
         {
-            int16_t droop = (int16_t)(20 * fabs(sin(bounce_counter * 0.03)));
+            int16_t droop = (int16_t)anim_abs_sin(ms, ANIM_RATE(0.03), 20);
             int16_t new_open = 35 - droop;
             face_state.left_eye_openness = (uint8_t)(new_open < 10 ? 10 : new_open);
             face_state.right_eye_openness = face_state.left_eye_openness;
         }
-        if (bounce_counter % 3 == 0)
-            needs_redraw = true;
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 3))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_SURPRISED:
 
-        face_state.bounce_offset = (bounce_counter % 4) - 2;
+        set_bounce(Q8((int32_t)(tick % 4) - 2));
 
         if (transition_done && !face_state.is_blinking)
         {
-            face_state.left_eye_openness = (uint8_t)(93 + (int8_t)(7 * fabs(sin(bounce_counter * 0.4))));
+            face_state.left_eye_openness = (uint8_t)(93 + anim_abs_sin(ms, ANIM_RATE(0.4), 7));
             face_state.right_eye_openness = face_state.left_eye_openness;
         }
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_CRY:
 
-        face_state.bounce_offset = (int8_t)(2 * sin(bounce_counter * 0.6));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.6), Q8(2)));
 
         if (transition_done && !face_state.is_blinking)
         {
-            int16_t squeeze = (int16_t)(20 * fabs(sin(bounce_counter * 0.3)));
+            int16_t squeeze = (int16_t)anim_abs_sin(ms, ANIM_RATE(0.3), 20);
             int16_t new_open = 65 - squeeze;
             face_state.left_eye_openness = (uint8_t)(new_open < 30 ? 30 : new_open);
             face_state.right_eye_openness = face_state.left_eye_openness;
         }
-        face_state.blush_intensity = (uint8_t)(27 + (int8_t)(18 * fabs(sin(bounce_counter * 0.3))));
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        face_state.blush_intensity = (uint8_t)(27 + anim_abs_sin(ms, ANIM_RATE(0.3), 18));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_SAD:
 
-        face_state.bounce_offset = (int8_t)(1.5 * sin(bounce_counter * 0.06));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.06), Q8(1.5)));
 
-        face_state.pupil_offset_y = (int8_t)(3 + (int8_t)(3 * fabs(sin(bounce_counter * 0.08))));
-        if (bounce_counter % 4 == 0)
-            needs_redraw = true;
+        set_pupil_y(Q8(3) + anim_abs_sin(ms, ANIM_RATE(0.08), Q8(3)));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 4))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_WINK:
 
-        face_state.sparkle_phase = (uint8_t)(42 + (int8_t)(38 * fabs(sin(bounce_counter * 0.2))));
+        face_state.sparkle_phase = (uint8_t)(42 + anim_abs_sin(ms, ANIM_RATE(0.2), 38));
 
-        face_state.bounce_offset = (int8_t)(1.5 * sin(bounce_counter * 0.25));
-        if (bounce_counter % 3 == 0)
-            needs_redraw = true;
+        set_bounce(anim_sin(ms, ANIM_RATE(0.25), Q8(1.5)));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 3))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_SMIRK:
 
         if (transition_done)
         {
-            face_state.left_eyebrow_angle = (int8_t)(12 + (int8_t)(8 * sin(bounce_counter * 0.10)));
-            face_state.eyebrow_height = (int8_t)(-5 + (int8_t)(4 * sin(bounce_counter * 0.10)));
+            face_state.left_eyebrow_angle = (int8_t)(12 + anim_sin(ms, ANIM_RATE(0.10), 8));
+            face_state.eyebrow_height = (int8_t)(-5 + anim_sin(ms, ANIM_RATE(0.10), 4));
         }
 
-        face_state.pupil_offset_x = (int8_t)(3 + (int8_t)(4 * sin(bounce_counter * 0.07)));
-        face_state.sparkle_phase = (uint8_t)(25 + (int8_t)(30 * fabs(sin(bounce_counter * 0.15))));
-        face_state.bounce_offset = (int8_t)(sin(bounce_counter * 0.10));
-        if (bounce_counter % 3 == 0)
-            needs_redraw = true;
+        set_pupil_x(Q8(3) + anim_sin(ms, ANIM_RATE(0.07), Q8(4)));
+        face_state.sparkle_phase = (uint8_t)(25 + anim_abs_sin(ms, ANIM_RATE(0.15), 30));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.10), Q8(1)));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 3))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_PLAYFUL:
 
         if (transition_done)
         {
-            face_state.mouth_curve = (int8_t)(105 + (int8_t)(10 * sin(bounce_counter * 0.35)));
+            face_state.mouth_curve = (int8_t)(105 + anim_sin(ms, ANIM_RATE(0.35), 10));
         }
-        face_state.sparkle_phase = (uint8_t)(62 + (int8_t)(28 * fabs(sin(bounce_counter * 0.28))));
+        face_state.sparkle_phase = (uint8_t)(62 + anim_abs_sin(ms, ANIM_RATE(0.28), 28));
 
-        face_state.bounce_offset = (int8_t)(2.5 * sin(bounce_counter * 0.30));
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        set_bounce(anim_sin(ms, ANIM_RATE(0.30), Q8(2.5)));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_SILLY:
 
-        face_state.bounce_offset = (int8_t)(3.5 * sin(bounce_counter * 0.25));
-        face_state.sparkle_phase = (uint8_t)(38 + (int8_t)(37 * fabs(sin(bounce_counter * 0.30))));
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        set_bounce(anim_sin(ms, ANIM_RATE(0.25), Q8(3.5)));
+        face_state.sparkle_phase = (uint8_t)(38 + anim_abs_sin(ms, ANIM_RATE(0.30), 37));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_WORKING_HARD:
 
-        face_state.bounce_offset = (bounce_counter % 6 < 3) ? 1 : -1;
-        if (bounce_counter % 6 == 0)
-            needs_redraw = true;
+        set_bounce((tick % 6 < 3) ? Q8(1) : Q8(-1));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 6))
+            dirty |= FACE_DIRTY_ALL;
         break;
 
     case FACE_EXCITED:
     {
 
-        face_state.bounce_offset = (int8_t)(3.5f * sinf(bounce_counter * 0.55f));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.55), Q8(3.5)));
 
         if (transition_done && !face_state.is_blinking)
         {
-            face_state.left_eye_openness = (uint8_t)(90 + (uint8_t)(10 * fabsf(sinf(bounce_counter * 0.55f))));
+            face_state.left_eye_openness = (uint8_t)(90 + anim_abs_sin(ms, ANIM_RATE(0.55), 10));
             face_state.right_eye_openness = face_state.left_eye_openness;
         }
 
-        face_state.sparkle_phase = (uint8_t)(80 + (uint8_t)(20 * fabsf(sinf(bounce_counter * 0.40f))));
-        face_state.blush_intensity = (uint8_t)(75 + (uint8_t)(20 * fabsf(sinf(bounce_counter * 0.20f))));
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        face_state.sparkle_phase = (uint8_t)(80 + anim_abs_sin(ms, ANIM_RATE(0.40), 20));
+        face_state.blush_intensity = (uint8_t)(75 + anim_abs_sin(ms, ANIM_RATE(0.20), 20));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
     }
 
     case FACE_CONFUSED:
     {
 
-        face_state.bounce_offset = (int8_t)(2.0f * sinf(bounce_counter * 0.07f) + 1.0f * sinf(bounce_counter * 0.19f));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.07), Q8(2)) + anim_sin(ms, ANIM_RATE(0.19), Q8(1)));
         if (transition_done)
         {
 
-            float brow_wave = sinf(bounce_counter * 0.06f);
-            face_state.left_eyebrow_angle = (int8_t)(-18 + (int8_t)(12 * brow_wave));
-            face_state.right_eyebrow_angle = (int8_t)(8 - (int8_t)(6 * brow_wave));
-            face_state.eyebrow_height = (int8_t)(-3 - (int8_t)(4 * fabsf(brow_wave)));
+            int32_t brow_wave = face_sin_q15(anim_phase(ms, ANIM_RATE(0.06)));
+            face_state.left_eyebrow_angle = (int8_t)(-18 + 12 * brow_wave / 32768);
+            face_state.right_eyebrow_angle = (int8_t)(8 - 6 * brow_wave / 32768);
+            face_state.eyebrow_height = (int8_t)(-3 - 4 * LV_ABS(brow_wave) / 32768);
         }
-        if (bounce_counter % 2 == 0)
-            needs_redraw = true;
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
         break;
     }
 
     case FACE_COOL:
     {
 
-        face_state.bounce_offset = (int8_t)(1.5f * sinf(bounce_counter * 0.04f));
+        set_bounce(anim_sin(ms, ANIM_RATE(0.04), Q8(1.5)));
 
-        face_state.sparkle_phase = (uint8_t)(15 + (uint8_t)(30 * fabsf(sinf(bounce_counter * 0.08f))));
+        face_state.sparkle_phase = (uint8_t)(15 + anim_abs_sin(ms, ANIM_RATE(0.08), 30));
 
         if (transition_done && !face_state.is_blinking)
         {
-            uint8_t squint = (uint8_t)(8 * fabsf(sinf(bounce_counter * 0.05f)));
+            uint8_t squint = (uint8_t)anim_abs_sin(ms, ANIM_RATE(0.05), 8);
             face_state.left_eye_openness = (uint8_t)(48 - (squint > 38 ? 38 : squint));
             face_state.right_eye_openness = face_state.left_eye_openness;
         }
-        if (bounce_counter % 3 == 0)
-            needs_redraw = true;
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 3))
+            dirty |= FACE_DIRTY_ALL;
         break;
     }
 
     case FACE_NEUTRAL:
     {
-
-        static uint32_t idle = 0;
+        face_state.idle_prev_ms = face_state.idle_ms;
         if (transition_done)
-            idle++;
+            face_state.idle_ms += dt;
 
-        face_state.bounce_offset = (int8_t)(1.2f * sinf(idle * 0.05f));
+        set_bounce(anim_sin(face_state.idle_ms, ANIM_RATE(0.05), Q8(1.2)));
 
-        uint32_t gp = idle % 420;
-        if (gp < 160)
+        int32_t gp = (int32_t)(face_state.idle_ms % ANIM_TICKS(420));
+        if (gp < ANIM_TICKS(160))
         {
 
-            face_state.pupil_offset_x = 0;
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(0);
+            set_pupil_y(0);
         }
-        else if (gp < 195)
+        else if (gp < ANIM_TICKS(195))
         {
 
-            float t = (gp - 160) / 35.0f;
-            face_state.pupil_offset_x = (int8_t)(7.0f * t);
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(Q8(7) * (gp - ANIM_TICKS(160)) / ANIM_TICKS(35));
+            set_pupil_y(0);
         }
-        else if (gp < 240)
+        else if (gp < ANIM_TICKS(240))
         {
 
-            face_state.pupil_offset_x = 7;
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(Q8(7));
+            set_pupil_y(0);
         }
-        else if (gp < 275)
+        else if (gp < ANIM_TICKS(275))
         {
 
-            float t = (gp - 240) / 35.0f;
-            face_state.pupil_offset_x = (int8_t)(7.0f * (1.0f - t));
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(Q8(7) * (ANIM_TICKS(275) - gp) / ANIM_TICKS(35));
+            set_pupil_y(0);
         }
-        else if (gp < 340)
+        else if (gp < ANIM_TICKS(340))
         {
 
-            face_state.pupil_offset_x = 0;
-            face_state.pupil_offset_y = 0;
+            set_pupil_x(0);
+            set_pupil_y(0);
         }
-        else if (gp < 368)
+        else if (gp < ANIM_TICKS(368))
         {
 
-            float t = (gp - 340) / 28.0f;
-            face_state.pupil_offset_x = (int8_t)(-5.0f * t);
-            face_state.pupil_offset_y = (int8_t)(5.0f * t);
+            int32_t u = gp - ANIM_TICKS(340);
+            set_pupil_x(Q8(-5) * u / ANIM_TICKS(28));
+            set_pupil_y(Q8(5) * u / ANIM_TICKS(28));
         }
-        else if (gp < 390)
+        else if (gp < ANIM_TICKS(390))
         {
 
-            face_state.pupil_offset_x = -5;
-            face_state.pupil_offset_y = 5;
+            set_pupil_x(Q8(-5));
+            set_pupil_y(Q8(5));
         }
         else
         {
 
-            float t = (gp - 390) / 30.0f;
-            face_state.pupil_offset_x = (int8_t)(-5.0f * (1.0f - t));
-            face_state.pupil_offset_y = (int8_t)(5.0f * (1.0f - t));
+            int32_t u = ANIM_TICKS(420) - gp;
+            set_pupil_x(Q8(-5) * u / ANIM_TICKS(30));
+            set_pupil_y(Q8(5) * u / ANIM_TICKS(30));
         }
 
         if (transition_done)
         {
 
-            uint32_t bp = idle % 280;
-            if (bp >= 230 && bp < 280)
+            /* Brow raise and micro-smile ramp up and back down */
+            int32_t bp = (int32_t)(face_state.idle_ms % ANIM_TICKS(280));
+            if (bp >= ANIM_TICKS(230))
             {
 
-                float raw_t = (bp - 230) / 25.0f;
-                float intensity = (raw_t <= 1.0f) ? raw_t : (2.0f - raw_t);
-                face_state.left_eyebrow_angle = (int8_t)(8.0f * intensity);
-                face_state.right_eyebrow_angle = (int8_t)(-2.0f * intensity);
-                face_state.eyebrow_height = (int8_t)(-4.0f * intensity);
+                int32_t u = bp - ANIM_TICKS(230);
+                int32_t ramp = (u <= ANIM_TICKS(25)) ? u : ANIM_TICKS(50) - u;
+                face_state.left_eyebrow_angle = (int8_t)(8 * ramp / ANIM_TICKS(25));
+                face_state.right_eyebrow_angle = (int8_t)(-2 * ramp / ANIM_TICKS(25));
+                face_state.eyebrow_height = (int8_t)(-4 * ramp / ANIM_TICKS(25));
             }
             else
             {
@@ -1901,13 +4231,13 @@ static void animation_timer_cb(lv_timer_t *timer)
                 face_state.eyebrow_height = 0;
             }
 
-            uint32_t sp = idle % 360;
-            if (sp >= 300 && sp < 360)
+            int32_t sp = (int32_t)(face_state.idle_ms % ANIM_TICKS(360));
+            if (sp >= ANIM_TICKS(300))
             {
 
-                float raw_t = (sp - 300) / 30.0f;
-                float intensity = (raw_t <= 1.0f) ? raw_t : (2.0f - raw_t);
-                face_state.mouth_curve = (int8_t)(14.0f * intensity);
+                int32_t u = sp - ANIM_TICKS(300);
+                int32_t ramp = (u <= ANIM_TICKS(30)) ? u : ANIM_TICKS(60) - u;
+                face_state.mouth_curve = (int8_t)(14 * ramp / ANIM_TICKS(30));
             }
             else
             {
@@ -1915,96 +4245,393 @@ static void animation_timer_cb(lv_timer_t *timer)
             }
         }
 
-        if (idle % 2 == 0)
-            needs_redraw = true;
-        break;
-    }
+        if (anim_crossed(face_state.idle_prev_ms, face_state.idle_ms, 2))
+            dirty |= FACE_DIRTY_ALL;
+        break;
+    }
+
+    default:
+        set_bounce(anim_sin(ms, ANIM_RATE(0.1), Q8(0.5)));
+        if (anim_crossed(face_state.anim_prev_ms, face_state.anim_ms, 10))
+            dirty |= FACE_DIRTY_ALL;
+        break;
+    }
+
+    if (face_state.current_emotion == FACE_NEUTRAL ||
+        face_state.current_emotion == FACE_ANGRY ||
+        face_state.current_emotion == FACE_SAD ||
+        face_state.current_emotion == FACE_CRY ||
+        face_state.current_emotion == FACE_SLEEPY ||
+        face_state.current_emotion == FACE_SURPRISED ||
+        face_state.current_emotion == FACE_WORKING_HARD ||
+        face_state.current_emotion == FACE_CONFUSED ||
+        face_state.current_emotion == FACE_WORRIED)
+    {
+        if (face_state.sparkle_phase > 0)
+        {
+            uint32_t fade = anim_advance(2);
+            face_state.sparkle_phase = (face_state.sparkle_phase >= fade)
+                                           ? face_state.sparkle_phase - fade
+                                           : 0;
+            dirty |= FACE_DIRTY_EYES;
+        }
+    }
+
+    if (face_state.current_emotion != FACE_LOVE)
+    {
+        if (face_state.heart_beat_phase > 0)
+        {
+            int32_t phase = face_state.heart_beat_phase +
+                            face_state.heart_direction * (int32_t)anim_advance(5);
+            face_state.heart_beat_phase = (uint8_t)LV_CLAMP(0, phase, 100);
+            if (face_state.heart_beat_phase <= 0)
+            {
+                face_state.heart_beat_phase = 0;
+                face_state.heart_direction = 1;
+            }
+            else if (face_state.heart_beat_phase >= 100)
+            {
+                face_state.heart_beat_phase = 100;
+                face_state.heart_direction = -1;
+            }
+        }
+    }
+
+    if (face_state.transition_progress < 100 && face_state.blush_intensity > 0)
+    {
+        dirty |= FACE_DIRTY_EYES;
+    }
+
+    if (face_state.config.update_policy == FACE_UPDATE_KEYFRAMES)
+    {
+        /* Only emotion changes and the closed/open edges of a blink are
+         * keyframes; the bounce is held at rest so keyframes line up. */
+        bool closed = face_state.is_blinking && face_state.left_eye_openness <= 20;
+
+        set_bounce(0);
+        bool keyframe = (face_state.current_emotion != face_state.keyframe_emotion) ||
+                        (closed != face_state.keyframe_closed);
+        dirty = keyframe ? FACE_DIRTY_ALL : 0;
+        face_state.keyframe_emotion = face_state.current_emotion;
+        face_state.keyframe_closed = closed;
+    }
+
+    return dirty;
+}
+
+/* Drop every pre-rendered frame; the next fill restarts from the live state */
+static void lookahead_reset(void)
+{
+    face_state.ahead_count = 0;
+}
+
+/*
+ * Pre-render the frame after the newest one in the ring.  face_state points
+ * at the simulation for the duration: it is stepped at the tick its timer
+ * is expected to fire and its dirty canvases render straight into the slot,
+ * as if under a render budget, so nothing is flushed.  Each slot starts as
+ * a copy of the frame before it, which keeps the unchanged canvases valid.
+ */
+static void lookahead_fill(void)
+{
+    face_state_t *live = &s_face_live;
+    uint8_t len = live->ahead_len;
+    uint8_t slot = (live->ahead_head + live->ahead_count) % len;
+    uint8_t prev = (slot + len - 1) % len;
+    bool first = (live->ahead_count == 0);
+
+    /* A fresh ring forks the simulation off the live state */
+    if (first)
+    {
+        *s_ahead_sim = *live;
+        live->ahead_time = live->step_time + live->config.animation_speed;
+    }
+
+    s_face = s_ahead_sim;
+
+    live->ahead_at[slot] = live->ahead_time;
+    uint8_t dirty = face_step(live->ahead_time) | face_state.dirty;
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        uint8_t *buf = live->ahead_buf[slot][p];
+        memcpy(buf, first ? part_buf((face_part_t)p) : live->ahead_buf[prev][p],
+               part_work_bytes((face_part_t)p));
+
+        face_state.back_buf[p] = buf;
+        face_state.back_stale[p] = false;
+        face_state.row_sums[p] = NULL;
+        if ((dirty & (1u << p)) || !face_state.pose_valid[p])
+            render_part((face_part_t)p);
+        live->ahead_pose[slot][p] = face_state.pose[p];
+    }
+    face_state.dirty = 0;
+    face_state.present_mask = 0;
+
+    s_face = live;
+    live->ahead_count++;
+    live->ahead_time += live->config.animation_speed;
+}
+
+/*
+ * Time to step the live face to at `now`.  Slots hold the state at their
+ * predicted tick, so a timer firing a few ms late steps to the newest slot
+ * time it has reached, not to now, and lands on that slot's pose exactly;
+ * the next step makes up the difference.  Slots it has overtaken are
+ * dropped, so a stall never leaves the face running behind the clock.
+ */
+static uint32_t lookahead_time(uint32_t now)
+{
+    while (face_state.ahead_count)
+    {
+        uint8_t slot = face_state.ahead_head;
+        if ((int32_t)(now - face_state.ahead_at[slot]) < 0)
+            break;
+
+        uint8_t next = (slot + 1) % face_state.ahead_len;
+        if (face_state.ahead_count == 1 || (int32_t)(now - face_state.ahead_at[next]) < 0)
+            return face_state.ahead_at[slot];
+
+        face_state.ahead_head = next;
+        face_state.ahead_count--;
+    }
+    return now;
+}
+
+/*
+ * Show the ring's next frame in place of rendering the step just taken.
+ * Every dirty canvas must be at the pose its slot was rendered for;
+ * otherwise the prediction went stale (an API call, a blink landing on a
+ * different tick) and the ring is dropped, leaving the caller to render on
+ * demand.
+ */
+static bool lookahead_present(void)
+{
+    if (!face_state.ahead_count)
+        return false;
+
+    uint8_t slot = face_state.ahead_head;
+    face_state.ahead_head = (slot + 1) % face_state.ahead_len;
+    face_state.ahead_count--;
 
-    default:
-        face_state.bounce_offset = (int8_t)(sinf(bounce_counter * 0.1f) * 0.5f);
-        if (bounce_counter % 10 == 0)
-            needs_redraw = true;
-        break;
+    if (!face_is_shown())
+    {
+        lookahead_reset();
+        return false;
     }
 
-    if (face_state.current_emotion == FACE_NEUTRAL ||
-        face_state.current_emotion == FACE_ANGRY ||
-        face_state.current_emotion == FACE_SAD ||
-        face_state.current_emotion == FACE_CRY ||
-        face_state.current_emotion == FACE_SLEEPY ||
-        face_state.current_emotion == FACE_SURPRISED ||
-        face_state.current_emotion == FACE_WORKING_HARD ||
-        face_state.current_emotion == FACE_CONFUSED ||
-        face_state.current_emotion == FACE_WORRIED)
+    face_pose_t pose[FACE_PART_COUNT];
+    for (int p = 0; p < FACE_PART_COUNT; p++)
     {
-        if (face_state.sparkle_phase > 0)
+        if (!(face_state.dirty & (1u << p)))
+            continue;
+
+        pose_capture((face_part_t)p, &pose[p]);
+        if (memcmp(&pose[p], &face_state.ahead_pose[slot][p], sizeof(face_pose_t)) != 0)
         {
-            face_state.sparkle_phase = (face_state.sparkle_phase >= 2)
-                                           ? face_state.sparkle_phase - 2
-                                           : 0;
-            needs_redraw = true;
+            lookahead_reset();
+            return false;
         }
     }
 
-    if (face_state.current_emotion != FACE_LOVE)
+    for (int p = 0; p < FACE_PART_COUNT; p++)
     {
-        if (face_state.heart_beat_phase > 0)
+        if (!(face_state.dirty & (1u << p)))
+            continue;
+        if (face_state.pose_valid[p] && memcmp(&pose[p], &face_state.pose[p], sizeof(face_pose_t)) == 0)
+            continue;
+
+        face_state.pose[p] = pose[p];
+        face_state.pose_valid[p] = true;
+        memcpy(part_buf((face_part_t)p), face_state.ahead_buf[slot][p], part_work_bytes((face_part_t)p));
+
+        uint16_t w, h;
+        part_size((face_part_t)p, &w, &h);
+        lv_area_t changed = {0, 0, w - 1, h - 1};
+        flush_changed((face_part_t)p, &changed);
+    }
+    face_state.dirty = 0;
+    return true;
+}
+
+uint8_t face_prerender_idle(uint32_t budget_us)
+{
+    if (!face_state.initialized || !face_state.ahead_len)
+        return 0;
+
+    face_lock();
+
+    /* Nothing worth predicting while a cross-fade runs or nobody looks */
+    if (!face_state.crossfading && face_is_shown())
+    {
+        int64_t start = face_time_us();
+        while (face_state.ahead_count < face_state.ahead_len &&
+               face_time_us() - start < (int64_t)budget_us)
         {
-            static int8_t heart_direction = -1;
-            face_state.heart_beat_phase += heart_direction * 5;
-            if (face_state.heart_beat_phase <= 0)
-            {
-                face_state.heart_beat_phase = 0;
-                heart_direction = 1;
-            }
-            else if (face_state.heart_beat_phase >= 100)
-            {
-                face_state.heart_beat_phase = 100;
-                heart_direction = -1;
-            }
+            lookahead_fill();
         }
     }
 
-    if (face_state.transition_progress < 100 && face_state.blush_intensity > 0)
+    uint8_t ready = face_state.ahead_count;
+    face_unlock();
+    return ready;
+}
+
+/* Show the state after one or more steps that changed `dirty` */
+static void animation_present(uint8_t dirty)
+{
+    if (face_state.crossfading)
+    {
+        /* The logic above keeps advancing; only the blend is shown */
+        lookahead_reset();
+        crossfade_step();
+    }
+    else
     {
-        needs_redraw = true;
+        face_state.dirty |= dirty;
+        if (face_state.back_buf[FACE_PART_LEFT_EYE])
+        {
+            render_sliced();
+        }
+        else if (!lookahead_present() && face_state.dirty)
+        {
+            render_parts(face_state.dirty);
+        }
     }
 
-    if (needs_redraw)
+    if (face_state.frame_changed)
     {
-        draw_eye(face_state.left_eye_canvas, face_state.left_eye_openness, true);
-        draw_eye(face_state.right_eye_canvas, face_state.right_eye_openness, false);
-        draw_mouth(face_state.mouth_canvas, face_state.mouth_curve);
+        face_state.frame_changed = false;
+        for (int i = 0; i < FACE_MAX_FRAME_CBS; i++)
+        {
+            if (face_state.frame_cbs[i])
+                face_state.frame_cbs[i](face_state.frame_cb_user_data[i]);
+        }
     }
 }
 
+static void animation_timer_cb(lv_timer_t *timer)
+{
+    LV_UNUSED(timer);
+
+    if (!face_state.initialized)
+        return;
+
+    animation_present(face_step(lookahead_time(face_now_ms())));
+}
+
+/* animation_speed 0 means "as often as possible"; never divide by it */
+static uint32_t sync_period(void)
+{
+    return LV_MAX(face_state.config.animation_speed, 1);
+}
+
+/*
+ * Refresh-synced driver, run as the display starts each refresh: once at
+ * least animation_speed has passed it steps the logic to now and renders
+ * once, so each rendered frame is flushed by the refresh that follows,
+ * exactly once.  The step itself catches up on the time a stall skipped.
+ */
+static void refr_start_cb(lv_event_t *e)
+{
+    LV_UNUSED(e);
+
+    if (!face_state.initialized)
+        return;
+
+    uint32_t now = lv_tick_get();
+    uint32_t period = sync_period();
+    face_state.sync_accum += now - face_state.sync_last;
+    face_state.sync_last = now;
+
+    if (face_state.sync_accum < period)
+        return;
+    face_state.sync_accum %= period;
+
+    animation_present(face_step(lookahead_time(now)));
+}
+
+/*
+ * LVGL pauses a display's refresh timer after a refresh with nothing to
+ * redraw, and only an invalidation resumes it.  While the refresh sleeps
+ * this timer takes the steps instead.  A step that changes a visible
+ * canvas invalidates it, which wakes the refresh to drive the steps again;
+ * a hidden face, a static emotion or a skipped keyframe costs a step and
+ * no refresh.
+ */
+static void sync_wake_cb(lv_timer_t *timer)
+{
+    LV_UNUSED(timer);
+
+    if (!face_state.initialized)
+        return;
+
+    uint32_t now = lv_tick_get();
+#if FACE_LVGL_VERSION_AT_LEAST(9, 1)
+    lv_timer_t *refr = lv_display_get_refr_timer(face_state.sync_disp);
+    if (refr && !lv_timer_get_paused(refr))
+        return;
+#else
+    /* A refresh within the last two periods is still driving the face */
+    if (now - face_state.sync_last < 2 * sync_period())
+        return;
+#endif
+
+    face_state.sync_last = now;
+    face_state.sync_accum = 0;
+    animation_present(face_step(lookahead_time(now)));
+}
+
+/* Jump straight to an emotion's resting parameters */
+static void apply_emotion(face_emotion_t emotion)
+{
+    face_state.current_emotion = emotion;
+    face_state.transition_progress = 100;
+
+    uint8_t left, right;
+    int8_t mouth, left_brow, right_brow, brow_height;
+    update_emotion_parameters(emotion, &left, &right, &mouth, &left_brow, &right_brow, &brow_height);
+
+    face_state.left_eye_openness = left;
+    face_state.right_eye_openness = right;
+    face_state.mouth_curve = mouth;
+    face_state.left_eyebrow_angle = left_brow;
+    face_state.right_eyebrow_angle = right_brow;
+    face_state.eyebrow_height = brow_height;
+    face_state.keyframe_emotion = emotion;
+}
+
 void face_set_emotion(face_emotion_t emotion, bool smooth)
 {
     if (!face_state.initialized || emotion >= FACE_EMOTION_COUNT)
         return;
 
     face_state.target_emotion = emotion;
+    lookahead_reset();
 
     if (!smooth)
     {
-        face_state.current_emotion = emotion;
-        face_state.transition_progress = 100;
+        face_lock();
+        crossfade_end();
+        apply_emotion(emotion);
+        render_all();
+        face_unlock();
+    }
+    else if (emotion != face_state.current_emotion && crossfade_available())
+    {
+        face_lock();
 
-        uint8_t left, right;
-        int8_t mouth, left_brow, right_brow, brow_height;
-        update_emotion_parameters(emotion, &left, &right, &mouth, &left_brow, &right_brow, &brow_height);
+        /* Cache the frame on screen and the first frame of the target and
+         * let the timer blend between the two.  The canvases still show the
+         * old frame, so nothing is flushed until the first blend. */
+        for (int p = 0; p < FACE_PART_COUNT; p++)
+            memcpy(face_state.fade_src[p], part_buf((face_part_t)p), part_work_bytes((face_part_t)p));
 
-        face_state.left_eye_openness = left;
-        face_state.right_eye_openness = right;
-        face_state.mouth_curve = mouth;
-        face_state.left_eyebrow_angle = left_brow;
-        face_state.right_eyebrow_angle = right_brow;
-        face_state.eyebrow_height = brow_height;
+        apply_emotion(emotion);
+        crossfade_render_target();
+
+        face_state.fade_progress = 0;
+        face_state.crossfading = true;
 
-        face_lock();
-        draw_eye(face_state.left_eye_canvas, face_state.left_eye_openness, true);
-        draw_eye(face_state.right_eye_canvas, face_state.right_eye_openness, false);
-        draw_mouth(face_state.mouth_canvas, face_state.mouth_curve);
         face_unlock();
     }
     else
@@ -2013,6 +4640,115 @@ void face_set_emotion(face_emotion_t emotion, bool smooth)
     }
 }
 
+esp_err_t face_render_thumbnail(face_emotion_t emotion, uint16_t size, lv_image_dsc_t *dsc)
+{
+    if (!dsc || emotion >= FACE_EMOTION_COUNT || size < 32)
+        return ESP_ERR_INVALID_ARG;
+#ifdef FACE_FIXED_SIZE
+    /* The geometry is baked in; only full-size thumbnails can be drawn */
+    if (size != FACE_FIXED_SIZE)
+        return ESP_ERR_INVALID_ARG;
+#endif
+
+    uint32_t stride = lv_draw_buf_width_to_stride(size, LV_COLOR_FORMAT_RGB565);
+    uint8_t *buf = FACE_MALLOC_CANVAS((size_t)stride * size);
+    face_frame_t *live = malloc(sizeof(face_frame_t));
+    if (!buf || !live)
+    {
+        free(buf);
+        free(live);
+        return ESP_ERR_NO_MEM;
+    }
+
+    face_lock();
+
+    /* Borrow the renderer: park the live pose and the settings below, swap
+     * in a thumbnail-sized geometry and the emotion's resting pose, draw
+     * each part headless through the SDF backend at its offset in the
+     * shared buffer, then put the live face back untouched. */
+    frame_capture(live);
+    face_render_mode_t mode = face_state.config.render_mode;
+    face_backend_t backend = face_state.config.backend;
+    uint16_t face_sz = FACE_SZ;
+    face_sdf_target_t target = face_state.sdf_target;
+    lv_area_t paint_area = face_state.paint_area;
+
+    face_state.config.render_mode = FACE_RENDER_RGB565;
+    if (!backend_is_mesh())
+        face_state.config.backend = FACE_BACKEND_SDF;
+    set_face_size(size);
+    face_state.current_emotion = emotion;
+    update_emotion_parameters(emotion, &face_state.left_eye_openness, &face_state.right_eye_openness,
+                              &face_state.mouth_curve, &face_state.left_eyebrow_angle,
+                              &face_state.right_eyebrow_angle, &face_state.eyebrow_height);
+    set_bounce(0);
+    set_pupil_x(0);
+    set_pupil_y(0);
+    fx_clear();
+    face_state.diamond_mouth_phase = (emotion == FACE_SURPRISED) ? 75 : 0;
+
+    face_state.sdf_target = (face_sdf_target_t){
+        .buf = buf,
+        .stride = stride,
+        .cf = LV_COLOR_FORMAT_RGB565,
+        .clip = {0, 0, size - 1, size - 1},
+    };
+    face_sdf_fill(&face_state.sdf_target, lv_color_white(), LV_OPA_COVER);
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        uint16_t w, h;
+        int16_t x, y;
+        part_size((face_part_t)p, &w, &h);
+        part_origin((face_part_t)p, &x, &y);
+
+        face_state.sdf_target.ox = x;
+        face_state.sdf_target.oy = y;
+        face_state.sdf_target.clip = (lv_area_t){x, y, x + w - 1, y + h - 1};
+        if (!area_clip(&face_state.sdf_target.clip, size, size))
+            continue;
+
+        if (p == FACE_PART_MOUTH)
+            draw_mouth(NULL, face_state.mouth_curve);
+        else
+            draw_eye(NULL, p == FACE_PART_LEFT_EYE ? face_state.left_eye_openness
+                                                   : face_state.right_eye_openness,
+                     p == FACE_PART_LEFT_EYE);
+    }
+
+    /* The drawn fields come back from the parked copy */
+    frame_swap(live);
+    set_face_size(face_sz);
+    face_state.config.render_mode = mode;
+    face_state.config.backend = backend;
+    face_state.sdf_target = target;
+    face_state.paint_area = paint_area;
+
+    face_unlock();
+    free(live);
+
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+    dsc->header.cf = LV_COLOR_FORMAT_RGB565;
+    dsc->header.w = size;
+    dsc->header.h = size;
+    dsc->header.stride = stride;
+    dsc->data_size = stride * size;
+    dsc->data = buf;
+
+    return ESP_OK;
+}
+
+void face_free_thumbnail(lv_image_dsc_t *dsc)
+{
+    if (!dsc)
+        return;
+
+    free((void *)dsc->data);
+    dsc->data = NULL;
+    dsc->data_size = 0;
+}
+
 face_emotion_t face_get_emotion(void)
 {
     return face_state.current_emotion;
@@ -2020,7 +4756,7 @@ face_emotion_t face_get_emotion(void)
 
 void face_animation_update(void)
 {
-    if (face_state.anim_timer)
+    if (face_state.anim_timer || face_state.sync_disp || matrix_mode())
     {
         animation_timer_cb(face_state.anim_timer);
     }
@@ -2033,10 +4769,11 @@ void face_set_eye_openness(uint8_t left_eye, uint8_t right_eye)
 
     face_state.left_eye_openness = left_eye > 100 ? 100 : left_eye;
     face_state.right_eye_openness = right_eye > 100 ? 100 : right_eye;
+    lookahead_reset();
 
     face_lock();
-    draw_eye(face_state.left_eye_canvas, face_state.left_eye_openness, true);
-    draw_eye(face_state.right_eye_canvas, face_state.right_eye_openness, false);
+    crossfade_end();
+    render_parts(FACE_DIRTY_EYES);
     face_unlock();
 }
 
@@ -2051,15 +4788,18 @@ void face_set_mouth_shape(int8_t value)
         value = -100;
 
     face_state.mouth_curve = value;
+    lookahead_reset();
 
     face_lock();
-    draw_mouth(face_state.mouth_canvas, face_state.mouth_curve);
+    crossfade_end();
+    render_parts(FACE_DIRTY_MOUTH);
     face_unlock();
 }
 
 void face_set_auto_blink(bool enable)
 {
     face_state.config.auto_blink = enable;
+    lookahead_reset();
 }
 
 void face_trigger_blink(void)
@@ -2067,8 +4807,8 @@ void face_trigger_blink(void)
     if (!face_state.initialized || face_state.is_blinking)
         return;
 
-    face_state.is_blinking = true;
-    face_state.blink_phase = 0;
+    lookahead_reset();
+    start_blink();
 }
 
 void face_set_position(int16_t x, int16_t y)
@@ -2076,10 +4816,103 @@ void face_set_position(int16_t x, int16_t y)
     if (!face_state.initialized)
         return;
 
+    if (matrix_mode())
+        return;
+
+    face_lock();
+
+    if (panel_mode())
+    {
+        /* The old area is left to the application to clear */
+        face_state.config.panel_x = x;
+        face_state.config.panel_y = y;
+        face_state.panel_clear = true;
+        render_all();
+    }
+    else
+    {
+        lv_obj_set_pos(face_state.face_container, x, y);
+    }
+    face_unlock();
+}
+
+/* A mirror deleted along with its parent, or by the application, gives
+ * back its slot so nothing touches the freed objects */
+static void mirror_delete_cb(lv_event_t *e)
+{
+    int m = (int)(intptr_t)lv_event_get_user_data(e);
+
+    face_state.mirrors[m] = NULL;
+    memset(face_state.mirror_imgs[m], 0, sizeof(face_state.mirror_imgs[m]));
+}
+
+lv_obj_t *face_add_mirror(lv_obj_t *parent)
+{
+    if (!face_state.initialized || !parent || panel_mode() || matrix_mode())
+        return NULL;
+
+    int slot = -1;
+    for (int m = 0; m < FACE_MAX_MIRRORS; m++)
+    {
+        if (!face_state.mirrors[m])
+        {
+            slot = m;
+            break;
+        }
+    }
+    if (slot < 0)
+    {
+        FACE_LOGW(TAG, "All %d mirror slots in use", FACE_MAX_MIRRORS);
+        return NULL;
+    }
+
     face_lock();
 
-    lv_obj_set_pos(face_state.face_container, x, y);
+    lv_obj_t *mirror = lv_obj_create(parent);
+    lv_obj_set_size(mirror, FACE_SZ, FACE_SZ);
+    lv_obj_center(mirror);
+    lv_obj_set_style_bg_opa(mirror, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(mirror, 0, 0);
+    lv_obj_set_style_pad_all(mirror, 0, 0);
+    lv_obj_clear_flag(mirror, LV_OBJ_FLAG_SCROLLABLE);
+
+    /* The images point at the canvases' own image descriptors, so the
+     * face is rendered once and every mirror shows the same pixels */
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        int16_t x, y;
+        part_origin((face_part_t)p, &x, &y);
+
+        lv_obj_t *img = lv_image_create(mirror);
+        lv_image_set_src(img, lv_canvas_get_image(part_canvas((face_part_t)p)));
+        lv_obj_set_pos(img, x, y);
+        face_state.mirror_imgs[slot][p] = img;
+    }
+
+    face_state.mirrors[slot] = mirror;
+    lv_obj_add_event_cb(mirror, mirror_delete_cb, LV_EVENT_DELETE, (void *)(intptr_t)slot);
+
     face_unlock();
+
+    return mirror;
+}
+
+void face_remove_mirror(lv_obj_t *mirror)
+{
+    if (!mirror)
+        return;
+
+    for (int m = 0; m < FACE_MAX_MIRRORS; m++)
+    {
+        if (face_state.mirrors[m] != mirror)
+            continue;
+
+        /* mirror_delete_cb frees the slot */
+        face_lock();
+        lv_obj_del(mirror);
+        face_unlock();
+        return;
+    }
 }
 
 lv_obj_t *face_get_container(void)
@@ -2087,6 +4920,173 @@ lv_obj_t *face_get_container(void)
     return face_state.initialized ? face_state.face_container : NULL;
 }
 
+uint16_t face_get_size(void)
+{
+    return face_state.initialized ? FACE_SZ : 0;
+}
+
+esp_err_t face_add_frame_cb(face_frame_cb_t cb, void *user_data)
+{
+    if (!cb)
+        return ESP_ERR_INVALID_ARG;
+
+    face_lock();
+    for (int i = 0; i < FACE_MAX_FRAME_CBS; i++)
+    {
+        if (!face_state.frame_cbs[i])
+        {
+            face_state.frame_cbs[i] = cb;
+            face_state.frame_cb_user_data[i] = user_data;
+            face_state.frame_changed = true;
+            face_unlock();
+            return ESP_OK;
+        }
+    }
+    face_unlock();
+
+    FACE_LOGW(TAG, "All %d frame callback slots in use", FACE_MAX_FRAME_CBS);
+    return ESP_ERR_NO_MEM;
+}
+
+void face_remove_frame_cb(face_frame_cb_t cb, void *user_data)
+{
+    face_lock();
+    for (int i = 0; i < FACE_MAX_FRAME_CBS; i++)
+    {
+        if (face_state.frame_cbs[i] == cb && face_state.frame_cb_user_data[i] == user_data)
+        {
+            face_state.frame_cbs[i] = NULL;
+            face_state.frame_cb_user_data[i] = NULL;
+        }
+    }
+    face_unlock();
+}
+
+/* One displayed canvas pixel as RGB565, transparent modes over white */
+static uint16_t part_pixel_rgb565(const uint8_t *buf, uint16_t w, uint16_t h, int32_t x, int32_t y)
+{
+    switch (face_state.config.render_mode)
+    {
+    case FACE_RENDER_MONO:
+    {
+        const uint8_t *row = buf + FACE_MONO_PALETTE_SIZE + y * lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_I1);
+        return (row[x / 8] & (0x80 >> (x & 7))) ? 0x0000 : 0xFFFF;
+    }
+    case FACE_RENDER_ARGB8888:
+    {
+        const uint8_t *p = buf + y * lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888) + x * 4;
+        uint16_t c = (uint16_t)(((p[2] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[0] >> 3));
+        return face_blend_rgb565(0xFFFF, c, p[3]);
+    }
+    case FACE_RENDER_RGB565A8:
+    {
+        uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+        uint16_t c = ((const uint16_t *)(buf + y * stride))[x];
+        return face_blend_rgb565(0xFFFF, c, buf[stride * h + y * (stride / 2) + x]);
+    }
+    case FACE_RENDER_RGB888:
+    case FACE_RENDER_XRGB8888:
+    {
+        uint32_t bpp = canvas_px_size();
+        const uint8_t *p = buf + y * lv_draw_buf_width_to_stride(w, canvas_format()) + x * bpp;
+        return (uint16_t)(((p[2] & 0xF8) << 8) | ((p[1] & 0xFC) << 3) | (p[0] >> 3));
+    }
+    case FACE_RENDER_RGB565_SWAPPED:
+    {
+        uint16_t c = ((const uint16_t *)(buf + y * lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565)))[x];
+        return (uint16_t)((c << 8) | (c >> 8));
+    }
+    default:
+        return ((const uint16_t *)(buf + y * lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565)))[x];
+    }
+}
+
+bool face_snapshot_supported(void)
+{
+    return face_state.initialized && !panel_mode() && !matrix_mode();
+}
+
+/* Compose the canvases into buf; the caller holds the LVGL lock */
+static void snapshot_compose(uint16_t *buf)
+{
+    uint16_t face_sz = FACE_SZ;
+    for (uint32_t i = 0; i < (uint32_t)face_sz * face_sz; i++)
+        buf[i] = 0xFFFF;
+
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        uint16_t w, h;
+        int16_t ox, oy;
+        part_size((face_part_t)p, &w, &h);
+        part_origin((face_part_t)p, &ox, &oy);
+        const uint8_t *src = part_buf((face_part_t)p);
+
+        int32_t cols = LV_MIN(w, face_sz - ox);
+        uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+
+        for (int32_t y = 0; y < h && oy + y < face_sz; y++)
+        {
+            uint16_t *row = buf + (oy + y) * face_sz + ox;
+            /* Opaque RGB565 rows are already what is shown */
+            if (face_state.config.render_mode == FACE_RENDER_RGB565)
+            {
+                memcpy(row, src + y * stride, cols * sizeof(uint16_t));
+                continue;
+            }
+            for (int32_t x = 0; x < cols; x++)
+                row[x] = part_pixel_rgb565(src, w, h, x, y);
+        }
+    }
+}
+
+esp_err_t face_snapshot_rgb565(uint16_t *buf)
+{
+    if (!face_state.initialized || !buf)
+        return ESP_ERR_INVALID_ARG;
+    if (!face_snapshot_supported())
+        return ESP_ERR_NOT_SUPPORTED;
+
+    face_lock();
+    snapshot_compose(buf);
+    face_unlock();
+    return ESP_OK;
+}
+
+esp_err_t face_frame_snapshot_rgb565(uint16_t *buf)
+{
+    if (!face_state.initialized || !buf)
+        return ESP_ERR_INVALID_ARG;
+    if (!face_snapshot_supported())
+        return ESP_ERR_NOT_SUPPORTED;
+
+    snapshot_compose(buf);
+    return ESP_OK;
+}
+
+void face_panel_flush_ready(void)
+{
+    /* Called from the transfer's ISR or task, never for the simulation */
+    uint8_t b = s_face_live.panel_done;
+    s_face_live.panel_busy[b] = false;
+    s_face_live.panel_done = b ^ 1;
+
+#ifdef ESP_PLATFORM
+    if (!s_panel_sem)
+        return;
+    if (xPortInIsrContext())
+    {
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(s_panel_sem, &woken);
+        if (woken)
+            portYIELD_FROM_ISR();
+    }
+    else
+    {
+        xSemaphoreGive(s_panel_sem);
+    }
+#endif
+}
+
 void face_animation_deinit(void)
 {
     if (!face_state.initialized)
@@ -2099,6 +5099,13 @@ void face_animation_deinit(void)
         lv_timer_del(face_state.anim_timer);
         face_state.anim_timer = NULL;
     }
+    if (face_state.sync_timer)
+    {
+        lv_timer_del(face_state.sync_timer);
+        face_state.sync_timer = NULL;
+    }
+    if (face_state.sync_disp)
+        lv_display_remove_event_cb_with_user_data(face_state.sync_disp, refr_start_cb, NULL);
 
     if (face_state.left_eye_canvas)
         lv_obj_del(face_state.left_eye_canvas);
@@ -2106,19 +5113,55 @@ void face_animation_deinit(void)
         lv_obj_del(face_state.right_eye_canvas);
     if (face_state.mouth_canvas)
         lv_obj_del(face_state.mouth_canvas);
+    if (face_state.render_canvas)
+        lv_obj_del(face_state.render_canvas);
     if (face_state.face_container)
         lv_obj_del(face_state.face_container);
+    for (int m = 0; m < FACE_MAX_MIRRORS; m++)
+    {
+        if (face_state.mirrors[m])
+            lv_obj_del(face_state.mirrors[m]);
+    }
 
     face_unlock();
 
+    /* A strip may still be on the wire; one that never completes is
+     * leaked rather than freed under the transfer */
+    for (uint8_t b = 0; b < 2; b++)
+    {
+        if (panel_wait(b, 100))
+            free(face_state.panel_strip[b]);
+        else
+            FACE_LOGW(TAG, "Panel strip %u still busy, not freed", b);
+    }
+    free(face_state.matrix_buf[0]);
+    free(face_state.matrix_buf[1]);
+    free(face_state.tile_buf);
+
     if (face_state.left_eye_buf)
         free(face_state.left_eye_buf);
     if (face_state.right_eye_buf)
         free(face_state.right_eye_buf);
     if (face_state.mouth_buf)
         free(face_state.mouth_buf);
+    if (face_state.scratch_buf)
+        free(face_state.scratch_buf);
+    for (int p = 0; p < FACE_PART_COUNT; p++)
+    {
+        free(face_state.fade_src[p]);
+        free(face_state.fade_dst[p]);
+        free(face_state.row_sums[p]);
+        free(face_state.back_buf[p]);
+        for (int i = 0; i < FACE_MAX_LOOKAHEAD; i++)
+            free(face_state.ahead_buf[i][p]);
+    }
+
+    free(face_state.slice_frame);
+    free(s_ahead_sim);
+    s_ahead_sim = NULL;
 
     memset(&face_state, 0, sizeof(face_state_t));
+    s_face_headless = false;
 
     FACE_LOGI(TAG, "Face animation deinitialized");
 }